@@ -0,0 +1,377 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "math/simd.hpp"
+#include "math/Matrix.hpp"
+#include "math/Vector.hpp"
+#include "math/Affine.hpp"
+#include "math/Batch.hpp"
+#include "math/Frustum.hpp"
+#include "math/Trig.hpp"
+#include "math/pi.hpp"
+#include "TransformHierarchy.hpp"
+
+namespace {
+    constexpr size_t input_count = 256;
+    constexpr int repetitions = 7;
+
+    template <typename T>
+    void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static const volatile void* sink;
+        sink = &value;
+#endif
+    }
+
+    struct Result {
+        std::string name;
+        double ns_per_op;
+        size_t operations;
+    };
+
+    // Runs body(operations) repeatedly and keeps the fastest run, which is the least disturbed by the OS.
+    template <typename Body>
+    Result measure(std::string name, size_t operations, Body body) {
+        body(operations / 16);
+
+        double best = 0.0;
+        for (int i = 0; i < repetitions; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            body(operations);
+            auto end = std::chrono::steady_clock::now();
+
+            double ns = std::chrono::duration<double, std::nano>(end - start).count() / (double)operations;
+            if (i == 0 || ns < best) {
+                best = ns;
+            }
+        }
+
+        return Result{std::move(name), best, operations};
+    }
+
+    float next_float(uint32_t& state) {
+        state = state * 1664525u + 1013904223u;
+        return (float)(state >> 8) / (float)(1u << 24) * 2.0f - 1.0f;
+    }
+
+    std::vector<Result> run_benchmarks() {
+        uint32_t seed = 12345;
+
+        std::vector<math::Matrix4f> matrices(input_count);
+        std::vector<math::Vector4f> vectors(input_count);
+        std::vector<math::Affine3f> affines(input_count);
+        std::vector<float> angles(input_count);
+        for (size_t i = 0; i < input_count; ++i) {
+            for (size_t j = 0; j < 16; ++j) {
+                matrices[i].data()[j] = next_float(seed);
+            }
+
+            vectors[i] = math::Vector4f(next_float(seed), next_float(seed), next_float(seed), next_float(seed) + 2.0f);
+            angles[i] = next_float(seed) * math::pi<float>();
+            affines[i] = math::Affine3f::from_rotation_translation(
+                math::Quaternionf::from_axis_angle(math::Vector3f(0.0f, 1.0f, 0.0f), angles[i]),
+                math::Vector3f(next_float(seed), next_float(seed), next_float(seed))
+            );
+        }
+
+        std::vector<Result> results;
+
+        results.push_back(measure("matrix4_multiply", 1 << 22, [&](size_t operations) {
+            for (size_t i = 0; i < operations; ++i) {
+                math::Matrix4f result = matrices[i % input_count] * matrices[(i + 1) % input_count];
+                do_not_optimize(result);
+            }
+        }));
+
+        results.push_back(measure("matrix4_vector4_multiply", 1 << 23, [&](size_t operations) {
+            for (size_t i = 0; i < operations; ++i) {
+                math::Vector4f result = matrices[i % input_count] * vectors[(i + 1) % input_count];
+                do_not_optimize(result);
+            }
+        }));
+
+        results.push_back(measure("vector4_normalize", 1 << 23, [&](size_t operations) {
+            for (size_t i = 0; i < operations; ++i) {
+                math::Vector4f result = vectors[i % input_count].normalize();
+                do_not_optimize(result);
+            }
+        }));
+
+        results.push_back(measure("perspective_projection", 1 << 22, [&](size_t operations) {
+            for (size_t i = 0; i < operations; ++i) {
+                math::Matrix4f result = math::perspective_projection(1.0f + angles[i % input_count] * 0.1f, 1.5f, 0.1f, 100.0f);
+                do_not_optimize(result);
+            }
+        }));
+
+        results.push_back(measure("rotation_x", 1 << 22, [&](size_t operations) {
+            for (size_t i = 0; i < operations; ++i) {
+                math::Matrix4f result = math::rotation_x(angles[i % input_count]);
+                do_not_optimize(result);
+            }
+        }));
+
+        results.push_back(measure("rotation_y", 1 << 22, [&](size_t operations) {
+            for (size_t i = 0; i < operations; ++i) {
+                math::Matrix4f result = math::rotation_y(angles[i % input_count]);
+                do_not_optimize(result);
+            }
+        }));
+
+        results.push_back(measure("affine_compose", 1 << 22, [&](size_t operations) {
+            for (size_t i = 0; i < operations; ++i) {
+                math::Affine3f result = affines[i % input_count] * affines[(i + 1) % input_count];
+                do_not_optimize(result);
+            }
+        }));
+
+        results.push_back(measure("affine_inverse", 1 << 22, [&](size_t operations) {
+            for (size_t i = 0; i < operations; ++i) {
+                math::Affine3f result = affines[i % input_count].inverse();
+                do_not_optimize(result);
+            }
+        }));
+
+        constexpr size_t batch_size = 4096;
+        std::vector<float> xs(batch_size), ys(batch_size), zs(batch_size);
+        std::vector<float> out_x(batch_size), out_y(batch_size), out_z(batch_size), out_w(batch_size);
+        std::vector<float> max_xs(batch_size), max_ys(batch_size), max_zs(batch_size);
+        std::vector<float> out_max_x(batch_size), out_max_y(batch_size), out_max_z(batch_size);
+        std::vector<math::Containment> containment(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            xs[i] = next_float(seed) * 200.0f;
+            ys[i] = next_float(seed) * 200.0f;
+            zs[i] = next_float(seed) * 200.0f;
+            max_xs[i] = xs[i] + 32.0f;
+            max_ys[i] = ys[i] + 32.0f;
+            max_zs[i] = zs[i] + 32.0f;
+        }
+
+        math::PointStreams<float> points{xs, ys, zs};
+        math::PointStreams<float> transformed{out_x, out_y, out_z};
+        math::AABBStreams<float> boxes{points, {max_xs, max_ys, max_zs}};
+        math::AABBStreams<float> transformed_boxes{transformed, {out_max_x, out_max_y, out_max_z}};
+        math::Matrix4f view_projection = math::perspective_projection(1.5f, 1.5f, 0.1f, 500.0f) * math::rotation_x(0.3f) * math::rotation_y(0.7f);
+        math::Frustum frustum = math::Frustum::from_matrix(view_projection);
+
+        results.push_back(measure("batch_transform_points", batch_size * 1024, [&](size_t operations) {
+            for (size_t i = 0; i < operations; i += batch_size) {
+                math::transform_points(matrices[(i / batch_size) % input_count], points, transformed);
+                do_not_optimize(out_x[0]);
+            }
+        }));
+
+        results.push_back(measure("batch_project_points", batch_size * 1024, [&](size_t operations) {
+            for (size_t i = 0; i < operations; i += batch_size) {
+                math::project_points(matrices[(i / batch_size) % input_count], points, transformed, out_w);
+                do_not_optimize(out_w[0]);
+            }
+        }));
+
+        results.push_back(measure("batch_transform_aabbs", batch_size * 512, [&](size_t operations) {
+            for (size_t i = 0; i < operations; i += batch_size) {
+                math::transform_aabbs(matrices[(i / batch_size) % input_count], boxes, transformed_boxes);
+                do_not_optimize(out_x[0]);
+            }
+        }));
+
+        results.push_back(measure("batch_frustum_classify_aabbs", batch_size * 512, [&](size_t operations) {
+            for (size_t i = 0; i < operations; i += batch_size) {
+                frustum.classify_aabbs(boxes, containment);
+                do_not_optimize(containment[0]);
+            }
+        }));
+
+        std::vector<float> sines(batch_size), cosines(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            out_w[i] = next_float(seed) * 100.0f;
+        }
+
+        results.push_back(measure("batch_fast_sincos", batch_size * 1024, [&](size_t operations) {
+            for (size_t i = 0; i < operations; i += batch_size) {
+                math::fast_sincos(out_w, sines, cosines);
+                do_not_optimize(sines[0]);
+            }
+        }));
+
+        results.push_back(measure("std_sincos", batch_size * 256, [&](size_t operations) {
+            for (size_t i = 0; i < operations; i += batch_size) {
+                for (size_t j = 0; j < batch_size; ++j) {
+                    sines[j] = std::sin(out_w[j]);
+                    cosines[j] = std::cos(out_w[j]);
+                }
+                do_not_optimize(sines[0]);
+            }
+        }));
+
+        // Trees four wide below one root, added breadth first as a scene would be. Timings are per
+        // node, since update makes one pass over all of them; a flat ns/node across the two sizes
+        // shows the pass stays linear.
+        auto build_hierarchy = [](TransformHierarchy& hierarchy, size_t depth) {
+            std::vector<TransformHierarchy::Node> nodes;
+            nodes.push_back(hierarchy.add(math::translation(0.0f, 0.0f, 0.0f)));
+            size_t level_start = 0;
+            for (size_t level = 0; level < depth; ++level) {
+                size_t level_end = nodes.size();
+                for (size_t parent = level_start; parent < level_end; ++parent) {
+                    for (size_t child = 0; child < 4; ++child) {
+                        nodes.push_back(hierarchy.add(math::translation(1.0f, 0.5f, 0.0f), nodes[parent]));
+                    }
+                }
+
+                level_start = level_end;
+            }
+
+            return nodes;
+        };
+
+        for (size_t depth : {4, 7}) {
+            TransformHierarchy hierarchy;
+            std::vector<TransformHierarchy::Node> nodes = build_hierarchy(hierarchy, depth);
+            size_t node_count = hierarchy.size();
+            results.push_back(measure("transform_hierarchy_update_" + std::to_string(node_count), (size_t)1 << 22, [&](size_t operations) {
+                for (size_t i = 0; i < operations; i += node_count) {
+                    hierarchy.set_local(nodes.front(), math::translation((float)(i / node_count % 64), 0.0f, 0.0f));
+                    hierarchy.update();
+                    do_not_optimize(hierarchy.get_world(nodes.back()));
+                }
+            }));
+        }
+
+        constexpr size_t hierarchy_depth = 7;
+        TransformHierarchy hierarchy;
+        std::vector<TransformHierarchy::Node> hierarchy_nodes = build_hierarchy(hierarchy, hierarchy_depth);
+        size_t hierarchy_size = hierarchy.size();
+        TransformHierarchy::Node hierarchy_root = hierarchy_nodes.front();
+        TransformHierarchy::Node hierarchy_subtree = hierarchy_nodes[1];
+        // Breadth first order puts the first node of the deepest level under the first child.
+        TransformHierarchy::Node hierarchy_leaf = hierarchy_nodes[hierarchy_size - ((size_t)1 << (2 * hierarchy_depth))];
+
+        // Only a quarter of the tree is dirty, but the pass still walks every node.
+        results.push_back(measure("transform_hierarchy_update_subtree", (size_t)1 << 22, [&](size_t operations) {
+            for (size_t i = 0; i < operations; i += hierarchy_size) {
+                hierarchy.set_local(hierarchy_subtree, math::translation(1.0f, 0.5f, (float)(i / hierarchy_size % 64)));
+                hierarchy.update();
+                do_not_optimize(hierarchy.get_world(hierarchy_leaf));
+            }
+        }));
+
+        // Every step adds exactly representable offsets, so the leaf must match exactly.
+        hierarchy.set_local(hierarchy_root, math::translation(3.0f, 0.0f, 0.0f));
+        hierarchy.set_local(hierarchy_subtree, math::translation(1.0f, 0.5f, 2.0f));
+        hierarchy.update();
+        const float* leaf_world = hierarchy.get_world(hierarchy_leaf).data();
+        if (leaf_world[12] != 3.0f + (float)hierarchy_depth || leaf_world[13] != 0.5f * (float)hierarchy_depth || leaf_world[14] != 2.0f) {
+            throw std::runtime_error("transform hierarchy produced a wrong world matrix");
+        }
+
+        return results;
+    }
+
+    std::string to_json(const std::vector<Result>& results) {
+        std::ostringstream stream;
+        stream << "{\n";
+        stream << "    \"simd\": \"" << math::simd::NAME << "\",\n";
+        stream << "    \"results\": {\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            char line[256];
+            std::snprintf(
+                line, sizeof(line), "        \"%s\": {\"ns_per_op\": %.4f, \"operations\": %zu}%s\n",
+                results[i].name.c_str(), results[i].ns_per_op, results[i].operations, i + 1 < results.size() ? "," : ""
+            );
+            stream << line;
+        }
+        stream << "    }\n";
+        stream << "}\n";
+        return stream.str();
+    }
+
+    // Reads back the one-result-per-line layout written by to_json; this is not a general JSON parser.
+    std::map<std::string, double> read_baseline(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("failed to open baseline file '" + filename + '\'');
+        }
+
+        std::map<std::string, double> baseline;
+        std::string line;
+        while (std::getline(file, line)) {
+            size_t key_start = line.find('"');
+            size_t value_start = line.find("\"ns_per_op\":");
+            if (key_start == std::string::npos || value_start == std::string::npos) {
+                continue;
+            }
+
+            size_t key_end = line.find('"', key_start + 1);
+            baseline[line.substr(key_start + 1, key_end - key_start - 1)] =
+                std::strtod(line.c_str() + value_start + std::string_view("\"ns_per_op\":").size(), nullptr);
+        }
+
+        return baseline;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string output_filename;
+    std::string baseline_filename;
+    double tolerance = 0.10;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view argument = argv[i];
+        if (argument == "--output" && i + 1 < argc) {
+            output_filename = argv[++i];
+        } else if (argument == "--baseline" && i + 1 < argc) {
+            baseline_filename = argv[++i];
+        } else if (argument == "--tolerance" && i + 1 < argc) {
+            tolerance = std::strtod(argv[++i], nullptr);
+        } else {
+            std::cerr << "usage: math_bench [--output file.json] [--baseline file.json] [--tolerance 0.10]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<Result> results = run_benchmarks();
+    std::string json = to_json(results);
+
+    if (output_filename.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream file(output_filename);
+        file << json;
+    }
+
+    if (baseline_filename.empty()) {
+        return 0;
+    }
+
+    int regressions = 0;
+    std::map<std::string, double> baseline = read_baseline(baseline_filename);
+    for (const Result& result : results) {
+        auto it = baseline.find(result.name);
+        if (it == baseline.end() || it->second <= 0.0) {
+            continue;
+        }
+
+        double change = result.ns_per_op / it->second - 1.0;
+        if (change > tolerance) {
+            std::cerr << "regression: " << result.name << " " << it->second << " -> " << result.ns_per_op
+                << " ns/op (+" << (int)(change * 100.0) << "%)" << std::endl;
+            ++regressions;
+        }
+    }
+
+    return regressions == 0 ? 0 : 1;
+}
\ No newline at end of file
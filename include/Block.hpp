@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+enum class Block : uint8_t {
+    Air,
+    Stone,
+    Dirt,
+    Grass,
+    Sand,
+    Log,
+    Leaves,
+    COUNT
+};
+
+enum class Face : uint8_t {
+    East,
+    West,
+    Up,
+    Down,
+    South,
+    North
+};
+
+inline constexpr size_t FACE_COUNT = 6;
+
+// Unit offset towards the neighbour each face looks at, indexed by Face.
+inline constexpr std::array<std::array<int, 3>, FACE_COUNT> FACE_DIRECTIONS = {{
+    {1, 0, 0},
+    {-1, 0, 0},
+    {0, 1, 0},
+    {0, -1, 0},
+    {0, 0, 1},
+    {0, 0, -1}
+}};
+
+constexpr bool is_opaque(Block block) {
+    return block != Block::Air && block != Block::Leaves;
+}
+
+// A face is drawn when something is there and the neighbour does not hide it; identical
+// see-through blocks (leaves next to leaves) hide each other too.
+constexpr bool is_face_visible(Block block, Block neighbour) {
+    return block != Block::Air && !is_opaque(neighbour) && neighbour != block;
+}
+
+// Layers of the block texture array; see BlockTextures.
+enum class TextureLayer : uint16_t {
+    Stone,
+    Dirt,
+    GrassTop,
+    GrassSide,
+    Sand,
+    LogSide,
+    LogTop,
+    Leaves,
+    COUNT
+};
+
+constexpr TextureLayer texture_layer(Block block, Face face) {
+    switch (block) {
+        case Block::Dirt: return TextureLayer::Dirt;
+        case Block::Grass: return face == Face::Up ? TextureLayer::GrassTop : (face == Face::Down ? TextureLayer::Dirt : TextureLayer::GrassSide);
+        case Block::Sand: return TextureLayer::Sand;
+        case Block::Log: return face == Face::Up || face == Face::Down ? TextureLayer::LogTop : TextureLayer::LogSide;
+        case Block::Leaves: return TextureLayer::Leaves;
+        default: return TextureLayer::Stone;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gfx.hpp"
+#include "GLState.hpp"
+#include "Block.hpp"
+
+// Every block face texture as one layer of a GL_TEXTURE_2D_ARRAY, indexed by TextureLayer. Layers
+// repeat and filter independently, so greedy quads can tile a texture across many blocks without
+// bleeding into their neighbours the way atlas tiles would, and all terrain still needs only one
+// texture binding. The textures are generated procedurally, since there are no image assets.
+class BlockTextures {
+public:
+    static constexpr GLsizei TEXTURE_SIZE = 16;
+    // Full mip chain down to 1x1.
+    static constexpr GLsizei LEVEL_COUNT = 5;
+    static constexpr GLfloat MAX_ANISOTROPY = 8.0f;
+
+    explicit BlockTextures(GLState& gl_state);
+    ~BlockTextures() noexcept;
+
+    BlockTextures(const BlockTextures&) = delete;
+    BlockTextures& operator=(const BlockTextures&) = delete;
+
+    void bind(GLuint unit);
+
+    // 1.0 when anisotropic filtering is not supported.
+    GLfloat get_anisotropy() const { return anisotropy; }
+
+private:
+    GLState& gl_state;
+    GLuint texture = 0;
+    GLfloat anisotropy = 1.0f;
+};
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <map>
+
+// Hands out ranges of a linear buffer, in whatever unit the owner counts in. Free ranges live in
+// an ordered map so a release coalesces with both neighbours; allocation is first fit.
+class BufferAllocator {
+public:
+    static constexpr size_t INVALID_OFFSET = std::numeric_limits<size_t>::max();
+
+    explicit BufferAllocator(size_t capacity);
+
+    // Returns INVALID_OFFSET when no single free range is large enough.
+    size_t allocate(size_t size);
+    void free(size_t offset, size_t size);
+
+    // Forgets every allocation, resizes, and marks [0, used) as allocated, for after the owner has
+    // compacted its data into a buffer of the new capacity.
+    void reset(size_t new_capacity, size_t used);
+
+    size_t get_capacity() const { return capacity; }
+    size_t get_free_size() const { return free_size; }
+
+private:
+    std::map<size_t, size_t> free_blocks;
+    size_t capacity = 0;
+    size_t free_size = 0;
+};
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+#include "math/Matrix.hpp"
+#include "math/Vector.hpp"
+#include "math/Quaternion.hpp"
+#include "math/Affine.hpp"
+#include "math/Frustum.hpp"
+
+// The camera lives in double precision world space but renders in camera-relative float space:
+// its view has no translation, and geometry is placed through to_render_space offsets.
+class Camera {
+public:
+    void set_position(const math::Vector3d& position);
+    void set_rotation(float yaw, float pitch);
+    void set_orientation(const math::Quaternionf& orientation);
+    void set_perspective(float FOV, float aspect_ratio, float near, float far);
+
+    const math::Vector3d& get_position() const { return position; }
+    const math::Quaternionf& get_orientation() const { return orientation; }
+
+    math::Vector3f get_forward() const;
+    math::Vector3f get_right() const;
+
+    math::Vector3f to_render_space(const math::Vector3d& world_position) const;
+
+    const math::Affine3f& get_view_transform() const;
+    const math::Matrix4f& get_view() const;
+    const math::Matrix4f& get_projection() const;
+    const math::Matrix4f& get_view_projection() const;
+    const math::Matrix4f& get_inverse_view_projection() const;
+    const math::Frustum& get_frustum() const;
+
+private:
+    enum Dirty : uint8_t {
+        View = 1 << 0,
+        Projection = 1 << 1,
+        ViewProjection = 1 << 2,
+        InverseViewProjection = 1 << 3,
+        Frustum = 1 << 4,
+        All = 0xFF
+    };
+
+    math::Vector3d position;
+    math::Quaternionf orientation;
+
+    // Last angles passed to set_rotation, so unchanged input skips rebuilding the quaternion.
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+
+    float FOV = 1.0f;
+    float aspect_ratio = 1.0f;
+    float near = 0.1f;
+    float far = 100.0f;
+
+    mutable uint8_t dirty = All;
+    mutable math::Affine3f view_transform;
+    mutable math::Matrix4f view;
+    mutable math::Matrix4f projection;
+    mutable math::Matrix4f inverse_projection;
+    mutable math::Matrix4f view_projection;
+    mutable math::Matrix4f inverse_view_projection;
+    mutable math::Frustum frustum;
+};
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gfx.hpp"
+#include "Block.hpp"
+#include "ChunkSection.hpp"
+#include "Vertex.hpp"
+#include "World.hpp"
+#include "math/Vector.hpp"
+
+// Bit for a pair of distinct faces in ChunkMeshData::face_connections; the 15 pairs are numbered
+// in order (East, West), (East, Up), ..., (South, North).
+constexpr uint16_t face_connection_bit(Face a, Face b) {
+    size_t first = std::min((size_t)a, (size_t)b);
+    size_t second = std::max((size_t)a, (size_t)b);
+    return (uint16_t)(1u << (first * (2 * FACE_COUNT - 1 - first) / 2 + (second - first - 1)));
+}
+
+inline constexpr uint16_t ALL_FACE_CONNECTIONS = (1u << (FACE_COUNT * (FACE_COUNT - 1) / 2)) - 1;
+
+// Four vertices per quad, in the winding the shared quad index buffer expects (0, 1, 2, 2, 3, 0).
+struct ChunkMeshData {
+    std::vector<Vertex> vertices;
+    // Layers at the bottom of the section that are entirely opaque. They form a box that hides
+    // whatever lies behind it, used for occlusion culling even when the mesh itself is empty.
+    uint8_t opaque_layers = 0;
+    // Pairs of faces joined by a path through non-opaque blocks, for cave culling.
+    uint16_t face_connections = 0;
+    // False when the mesher was asked to skip the two fields above, which then keep their defaults.
+    bool has_culling_data = true;
+
+    bool is_empty() const { return vertices.empty(); }
+};
+
+// A section's blocks plus a one block border taken from its six face neighbours, so meshing
+// needs nothing from the world and can run on any thread. Coordinates range over [-1, SIZE].
+struct PaddedSection {
+    static constexpr int SIZE = ChunkSection::SIZE + 2;
+    static constexpr size_t VOLUME = (size_t)SIZE * SIZE * SIZE;
+
+    static constexpr size_t index(int x, int y, int z) {
+        return ((size_t)(y + 1) * SIZE + (size_t)(z + 1)) * SIZE + (size_t)(x + 1);
+    }
+
+    Block get(int x, int y, int z) const { return blocks[index(x, y, z)]; }
+
+    std::array<Block, VOLUME> blocks = {};
+};
+
+class ChunkMesher {
+public:
+    enum class Mode : uint8_t {
+        // One quad per visible block face.
+        Naive,
+        // Coplanar faces of the same block merged into maximal rectangles.
+        Greedy,
+        // The greedy result, computed from per-axis occupancy bitmasks.
+        Binary,
+        COUNT
+    };
+
+    // Level of detail n meshes the section from cells of 2^n blocks a side.
+    static constexpr unsigned MAX_LOD = Vertex::MAX_LOD;
+
+    static const char* get_mode_name(Mode mode);
+
+    static void gather(const World& world, const math::Vector3i64& section, PaddedSection& padded);
+    // Occlusion and connectivity data always come from the full resolution blocks. They only depend
+    // on the blocks, so a remesh that just changes the level of detail can skip them.
+    static void mesh(const PaddedSection& padded, ChunkMeshData& mesh, Mode mode, unsigned lod = 0, bool culling_data = true);
+};
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "Block.hpp"
+
+class ChunkSection {
+public:
+    static constexpr unsigned SIZE_SHIFT = 5;
+    static constexpr int SIZE = 1 << SIZE_SHIFT;
+    static constexpr size_t VOLUME = (size_t)SIZE * SIZE * SIZE;
+
+    static constexpr size_t index(int x, int y, int z) {
+        assert(x >= 0 && x < SIZE && y >= 0 && y < SIZE && z >= 0 && z < SIZE);
+        return ((size_t)y << (2 * SIZE_SHIFT)) | ((size_t)z << SIZE_SHIFT) | (size_t)x;
+    }
+
+    Block get(int x, int y, int z) const {
+        return blocks[index(x, y, z)];
+    }
+
+    void set(int x, int y, int z, Block block) {
+        Block& current = blocks[index(x, y, z)];
+        non_air_count += (block != Block::Air) - (current != Block::Air);
+        current = block;
+    }
+
+    bool is_empty() const { return non_air_count == 0; }
+
+private:
+    std::array<Block, VOLUME> blocks = {};
+    uint32_t non_air_count = 0;
+};
\ No newline at end of file
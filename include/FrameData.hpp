@@ -0,0 +1,20 @@
+#pragma once
+
+#include "gfx.hpp"
+
+// Per-frame values shared by every program through one uniform buffer, mirroring the std140
+// FrameData block declared in the shaders. Only vec4-sized members, so the layouts agree
+// without padding rules getting involved.
+struct FrameData {
+    static constexpr GLuint BINDING = 0;
+    static constexpr const char* BLOCK_NAME = "FrameData";
+
+    GLfloat view_projection[16];
+    // World position of the camera; geometry itself is already camera-relative.
+    GLfloat camera_position[4];
+    GLfloat fog_color[4];
+    // x = fog start distance, y = fog end distance, z = seconds since startup.
+    GLfloat fog_time[4];
+};
+
+static_assert(sizeof(FrameData) == 112, "FrameData must match the std140 block");
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "gfx.hpp"
+
+// Shadows the slice of GL state the renderer touches so that setting something to its current
+// value never reaches the driver. Everything that binds or toggles tracked state has to go through
+// here, otherwise the shadow copy goes stale; call invalidate() after handing the context to code
+// that does not.
+class GLState {
+public:
+    struct Counters {
+        // glDraw* calls issued, and the draws they expand to (one per command of a multi-draw).
+        size_t draw_calls = 0;
+        size_t draw_commands = 0;
+        // Object bindings and fixed-function state changes that were forwarded to GL.
+        size_t binds = 0;
+        size_t state_changes = 0;
+        // Calls dropped because the state already matched.
+        size_t skipped = 0;
+    };
+
+    static constexpr size_t TEXTURE_UNITS = 16;
+
+    GLState();
+
+    GLState(const GLState&) = delete;
+    GLState& operator=(const GLState&) = delete;
+
+    // Forgets everything, so the next call for each piece of state goes through.
+    void invalidate();
+
+    // Moves this frame's counters to get_frame_counters() and starts counting again.
+    void begin_frame();
+    const Counters& get_frame_counters() const { return frame_counters; }
+
+    void use_program(GLuint program);
+    void bind_vertex_array(GLuint vertex_array);
+    // GL_ELEMENT_ARRAY_BUFFER belongs to the bound vertex array, so it is forwarded untracked.
+    void bind_buffer(GLenum target, GLuint buffer);
+    // Indexed binding points are not tracked, but the generic binding they also set is.
+    void bind_buffer_base(GLenum target, GLuint index, GLuint buffer);
+    void bind_texture(GLuint unit, GLenum target, GLuint texture);
+
+    void set_enabled(GLenum capability, bool enabled);
+    void set_depth_func(GLenum func);
+    void set_depth_mask(bool mask);
+    void set_blend_func(GLenum source, GLenum destination);
+    void set_cull_face(GLenum face);
+    void set_front_face(GLenum winding);
+    void set_viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    // Drop any cached binding of an object about to be deleted, since GL may reuse its name.
+    void forget_program(GLuint program);
+    void forget_vertex_array(GLuint vertex_array);
+    void forget_buffer(GLuint buffer);
+    void forget_texture(GLuint texture);
+
+    void count_draw(size_t commands = 1);
+
+private:
+    static constexpr GLuint UNKNOWN = std::numeric_limits<GLuint>::max();
+    static constexpr GLenum UNKNOWN_ENUM = std::numeric_limits<GLenum>::max();
+
+    enum class Tristate : uint8_t {Unknown, Off, On};
+
+    static constexpr std::array<GLenum, 5> BUFFER_TARGETS = {
+        GL_ARRAY_BUFFER, GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, GL_TEXTURE_BUFFER, GL_UNIFORM_BUFFER
+    };
+
+    static constexpr std::array<GLenum, 4> CAPABILITIES = {
+        GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND, GL_SCISSOR_TEST
+    };
+
+    struct TextureBinding {
+        GLenum target;
+        GLuint texture;
+    };
+
+    GLuint program;
+    GLuint vertex_array;
+    // Targets outside BUFFER_TARGETS (e.g. GL_DRAW_INDIRECT_BUFFER) share the last slot.
+    std::array<GLuint, BUFFER_TARGETS.size() + 1> buffers;
+    GLenum other_buffer_target;
+    GLuint active_texture_unit;
+    std::array<TextureBinding, TEXTURE_UNITS> textures;
+
+    std::array<Tristate, CAPABILITIES.size()> capabilities;
+    GLenum depth_func;
+    Tristate depth_mask;
+    GLenum blend_source;
+    GLenum blend_destination;
+    GLenum cull_face;
+    GLenum front_face;
+    std::array<GLint, 4> viewport;
+
+    Counters counters;
+    Counters frame_counters;
+
+    size_t get_buffer_slot(GLenum target);
+    void set_active_texture(GLuint unit);
+};
\ No newline at end of file
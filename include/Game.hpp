@@ -1,17 +1,49 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
 
 #include "gfx.hpp"
 
+class Renderer;
+
 class Game {
+public:
+    struct Options {
+        // Renders a scripted camera path offscreen with vsync off and prints frame statistics
+        // instead of opening an interactive window.
+        bool bench = false;
+        size_t bench_frames = 1000;
+        // When set, the bench writes per-frame GPU pass timings to this file as CSV.
+        std::string gpu_csv_filename;
+    };
+
+    explicit Game(const Options& options) : options(options) {}
+
+    void loop();
+
 private:
     GLFWwindow* glfw_window = nullptr;
+    Options options;
+    bool mesher_key_down = false;
+    bool occlusion_key_down = false;
+    bool cave_key_down = false;
+    bool lod_key_down = false;
+
     void create_glfw_window();
+    void handle_input(Renderer& renderer, int width, int height);
+    void run_interactive(Renderer& renderer);
+    void run_bench(Renderer& renderer);
 
     static constexpr uint32_t WIDTH = 1200;
     static constexpr uint32_t HEIGHT = 800;
 
-public:
-    void loop();
+    // Sections generated around the origin in each horizontal direction.
+    static constexpr int64_t WORLD_RADIUS = 8;
+
+    // The bench camera circles the origin once over the whole run, looking along its path.
+    static constexpr double BENCH_PATH_RADIUS = 120.0;
+    static constexpr double BENCH_PATH_HEIGHT = 90.0;
+    static constexpr float BENCH_PATH_PITCH = -0.25f;
 };
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gfx.hpp"
+#include "StringMap.hpp"
+
+// Times named passes on the GPU with GL_TIMESTAMP queries. Each frame's queries are only read
+// back FRAME_LATENCY frames later, by which point the GPU has normally finished them, so reading
+// never stalls the pipeline; a frame whose results are still not available is dropped instead.
+// Scopes may nest, since every scope brackets itself with its own pair of timestamps.
+class GpuProfiler {
+public:
+    static constexpr size_t FRAME_LATENCY = 4;
+    // Frames the rolling averages cover.
+    static constexpr size_t AVERAGE_FRAMES = 60;
+    // Resolved frames kept for write_csv; older ones are discarded.
+    static constexpr size_t HISTORY_FRAMES = 10000;
+
+    struct Pass {
+        std::string name;
+        double last_ms = 0.0;
+        double average_ms = 0.0;
+
+        std::array<double, AVERAGE_FRAMES> samples = {};
+        size_t sample_count = 0;
+        size_t next_sample = 0;
+        double sample_sum = 0.0;
+    };
+
+    // Brackets a pass for as long as it is in scope.
+    class Scope {
+    public:
+        Scope(GpuProfiler& profiler, std::string_view name) : profiler(profiler) { profiler.begin_scope(name); }
+        ~Scope() noexcept { profiler.end_scope(); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        GpuProfiler& profiler;
+    };
+
+    GpuProfiler() = default;
+    ~GpuProfiler() noexcept;
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // Collects the results of the frame issued FRAME_LATENCY frames ago and starts a new one.
+    void begin_frame();
+
+    void begin_scope(std::string_view name);
+    void end_scope();
+
+    const std::vector<Pass>& get_passes() const { return passes; }
+    const Pass* find_pass(std::string_view name) const;
+    size_t get_dropped_frames() const { return dropped_frames; }
+
+    // One row per resolved frame and one column per pass, in milliseconds.
+    void write_csv(std::ostream& stream) const;
+
+private:
+    struct Sample {
+        size_t pass;
+        size_t begin_query;
+        size_t end_query;
+    };
+
+    struct Frame {
+        uint64_t number = 0;
+        std::vector<GLuint> queries;
+        size_t used_queries = 0;
+        std::vector<Sample> samples;
+    };
+
+    struct HistoryRow {
+        uint64_t frame;
+        // Indexed by pass; negative when the pass did not run that frame.
+        std::vector<double> pass_ms;
+    };
+
+    std::array<Frame, FRAME_LATENCY> frames;
+    size_t current_frame = 0;
+    uint64_t frame_number = 0;
+    bool frame_started = false;
+
+    std::vector<Pass> passes;
+    StringMap<size_t> pass_indices;
+    std::vector<size_t> open_samples;
+
+    std::deque<HistoryRow> history;
+    size_t dropped_frames = 0;
+
+    size_t get_pass_index(std::string_view name);
+    GLuint issue_timestamp(Frame& frame, size_t& query_index);
+    void resolve(Frame& frame);
+};
\ No newline at end of file
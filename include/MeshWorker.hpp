@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ChunkMesher.hpp"
+
+// Meshes sections on background threads. Jobs carry their own copy of the blocks, and finished
+// meshes are handed back through poll so all GL work stays on the thread that owns the context.
+class MeshWorker {
+public:
+    struct Result {
+        uint64_t key;
+        // Echoes the version passed to submit, so results that finish out of order can be dropped.
+        uint32_t version;
+        ChunkMeshData mesh;
+    };
+
+    explicit MeshWorker(unsigned thread_count = 0);
+    ~MeshWorker() noexcept;
+
+    MeshWorker(const MeshWorker&) = delete;
+    MeshWorker& operator=(const MeshWorker&) = delete;
+
+    // The slot is stamped into every vertex of the result; see Vertex. The lod and culling_data
+    // arguments are passed on to ChunkMesher::mesh.
+    void submit(
+        uint64_t key, uint32_t version, uint32_t slot, std::unique_ptr<PaddedSection> blocks, ChunkMesher::Mode mode,
+        unsigned lod = 0, bool culling_data = true
+    );
+    void poll(std::vector<Result>& results);
+
+private:
+    struct Job {
+        uint64_t key;
+        uint32_t version;
+        uint32_t slot;
+        std::unique_ptr<PaddedSection> blocks;
+        ChunkMesher::Mode mode;
+        unsigned lod;
+        bool culling_data;
+    };
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable job_available;
+    std::deque<Job> jobs;
+    std::vector<Result> finished;
+    bool stopping = false;
+
+    void run();
+};
\ No newline at end of file
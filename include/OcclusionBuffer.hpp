@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "math/Matrix.hpp"
+#include "math/Vector.hpp"
+
+// A small CPU depth buffer for occlusion culling. Occluder boxes are rasterized into it, a
+// hierarchy of farthest depths is built on top, and candidate boxes are tested against the
+// hierarchy level where their screen bounds span only a few texels.
+//
+// Depth is stored as 1/w, which interpolates linearly in screen space and keeps its precision
+// far from the camera. Larger values are nearer; the buffer clears to 0, infinitely far away.
+// Every decision errs towards visible: occluders are pushed slightly back, their faces are
+// clipped against the camera plane instead of being projected through it, and any candidate
+// reaching behind the camera counts as visible.
+class OcclusionBuffer {
+public:
+    static constexpr size_t WIDTH = 256;
+    static constexpr size_t HEIGHT = 128;
+    static constexpr size_t LEVEL_COUNT = 8;
+
+    OcclusionBuffer();
+
+    // Boxes are given in the same space view_projection maps from.
+    void clear(const math::Matrix4f& view_projection);
+    void rasterize_box(const math::Vector3f& min, const math::Vector3f& max);
+    void build_hierarchy();
+
+    bool is_occluded(const math::Vector3f& min, const math::Vector3f& max) const;
+
+private:
+    struct ScreenVertex {
+        float x;
+        float y;
+        float inverse_depth;
+    };
+
+    math::Matrix4f view_projection;
+    std::array<std::vector<float>, LEVEL_COUNT> levels;
+
+    math::Vector4f to_clip(const math::Vector3f& point) const;
+    ScreenVertex to_screen(const math::Vector4f& clip) const;
+    void rasterize_triangle(ScreenVertex a, ScreenVertex b, ScreenVertex c);
+};
\ No newline at end of file
@@ -1,22 +1,222 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 #include "gfx.hpp"
+#include "GLState.hpp"
+#include "BlockTextures.hpp"
+#include "FrameData.hpp"
+#include "GpuProfiler.hpp"
+#include "OcclusionBuffer.hpp"
 #include "Shader.hpp"
 #include "ShaderProgram.hpp"
+#include "Camera.hpp"
+#include "World.hpp"
+#include "TerrainBuffer.hpp"
+#include "MeshWorker.hpp"
 #include "math/Matrix.hpp"
+#include "math/Frustum.hpp"
 
 class Renderer {
+public:
+    // CPU time spent in each stage of the last draw, in milliseconds.
+    struct FrameStats {
+        double upload_ms = 0.0;
+        double cull_ms = 0.0;
+        double submit_ms = 0.0;
+        size_t visible_sections = 0;
+        size_t occluded_sections = 0;
+        size_t cave_culled_sections = 0;
+        // Visible sections at each level of detail.
+        std::array<size_t, ChunkMesher::MAX_LOD + 1> lod_sections = {};
+    };
+
+    // Distance from the camera to a section's centre, in blocks, past which it is meshed at each
+    // coarser level of detail.
+    using LodDistances = std::array<double, ChunkMesher::MAX_LOD>;
+
 private:
-    GLuint VBO = 0;
-    GLuint VAO = 0;
-    GLuint EBO = 0;
+    // Starting size of the shared terrain buffer, which doubles whenever it runs out.
+    static constexpr size_t INITIAL_TERRAIN_VERTICES = 1 << 20;
+
+    // The section offset buffer texture takes unit 0.
+    static constexpr GLuint BLOCK_TEXTURE_UNIT = 1;
+
+    // Fog fades terrain into the clear colour before it reaches the edge of the generated world.
+    static constexpr GLfloat FOG_COLOR[4] = {0.1f, 0.15f, 0.3f, 1.0f};
+    static constexpr GLfloat FOG_START = 160.0f;
+    static constexpr GLfloat FOG_END = 250.0f;
+
+    // Only the nearest occluders are rasterized; far ones cover little of the screen.
+    static constexpr size_t MAX_OCCLUDERS = 256;
+    static constexpr float MAX_OCCLUDER_DISTANCE = 160.0f;
+
+    GLState gl_state;
     Shader vertex_shader = Shader(Shader::Type::Vertex);
     Shader fragment_shader = Shader(Shader::Type::Fragment);
     ShaderProgram shader_program = ShaderProgram();
-    math::Vector3f view_position;
+    Camera camera;
+
+    FrameData frame_data = {};
+    GLuint frame_data_buffer = 0;
+    double start_time = 0.0;
+
+    World& world;
+    MeshWorker mesh_worker;
+    ChunkMesher::Mode mesher_mode = ChunkMesher::Mode::Binary;
+    std::vector<MeshWorker::Result> finished_meshes;
+    TerrainBuffer terrain_buffer = TerrainBuffer(gl_state, INITIAL_TERRAIN_VERTICES);
+    BlockTextures block_textures = BlockTextures(gl_state);
+
+    struct SectionMesh {
+        TerrainBuffer::Handle handle = TerrainBuffer::INVALID_HANDLE;
+        // Index of this section's offset in the section offset buffer, baked into its vertices.
+        uint32_t slot = 0;
+        // Latest version requested; older results still in flight are dropped.
+        uint32_t version = 0;
+        // Level of detail of the latest request.
+        uint8_t lod = 0;
+        // Set until a result carrying the section's culling data arrives, so that a level of
+        // detail remesh replacing a request still in flight asks for it too.
+        bool culling_data_pending = true;
+    };
+
+    // Versions are unique across sections, so a result can never match a recreated entry.
+    uint32_t next_mesh_version = 0;
+    std::unordered_map<uint64_t, SectionMesh> section_meshes;
+    std::vector<uint32_t> free_slots;
+    uint32_t slot_count = 0;
+    size_t pending_meshes = 0;
+    // Set by remesh_all so the mesh totals are logged once it finishes, but not after the
+    // level of detail remeshes that trickle in while the camera moves.
+    bool log_remesh = false;
+
+    // Per-frame scratch for frustum culling, in structure-of-arrays form for the batched test.
+    std::vector<const SectionMesh*> cull_meshes;
+    std::vector<uint64_t> cull_keys;
+    std::vector<math::Vector3f> cull_offsets;
+    std::vector<float> cull_min_x, cull_min_y, cull_min_z;
+    std::vector<float> cull_max_x, cull_max_y, cull_max_z;
+    std::vector<math::Containment> cull_results;
+    std::vector<TerrainBuffer::Handle> visible_meshes;
+
+    // Face connectivity of every meshed section that is not open on all sides; sections missing
+    // from the map are treated as air. The bounds cover every meshed section.
+    std::unordered_map<uint64_t, uint16_t> section_connections;
+    math::Vector3i64 section_bounds_min;
+    math::Vector3i64 section_bounds_max;
+    bool has_section_bounds = false;
+
+    bool cave_culling = true;
+    // Faces the visibility search entered each section through this frame, over a grid spanning
+    // the section bounds plus a margin; zero for sections it never reached. The two spare bits
+    // mark the camera's own section and sections already found outside the frustum.
+    static constexpr uint8_t CAVE_START = 1u << FACE_COUNT;
+    static constexpr uint8_t CAVE_OUTSIDE_FRUSTUM = 1u << (FACE_COUNT + 1);
+    std::vector<uint8_t> cave_entered_faces;
+    math::Vector3i64 cave_grid_min;
+    math::Vector3i64 cave_grid_size;
+    bool cave_search_done = false;
+
+    struct CaveStep {
+        math::Vector3i64 section;
+        // FACE_COUNT for the camera's own section, which was not entered through any face.
+        size_t entry_face;
+    };
+
+    std::vector<CaveStep> cave_queue;
+
+    // Opaque layers of every section that has any, including sections with an empty mesh.
+    std::unordered_map<uint64_t, uint8_t> section_occluders;
+    bool occlusion_culling = true;
+    OcclusionBuffer occlusion_buffer;
+
+    struct Occluder {
+        float distance_squared;
+        math::Vector3f min;
+        math::Vector3f max;
+    };
+
+    std::vector<Occluder> occluders;
+
+    // The last level starts inside the fog, where the coarse cells are hard to make out.
+    static constexpr LodDistances DEFAULT_LOD_DISTANCES = {64.0, 128.0, 192.0};
+    // How far past a boundary a section must be before it switches level, so a camera hovering
+    // near one does not remesh the same sections back and forth.
+    static constexpr double LOD_HYSTERESIS = 8.0;
+    // Levels are only reconsidered once the camera has moved this far, a small enough fraction of
+    // the hysteresis band that no section can skip past it between passes.
+    static constexpr double LOD_UPDATE_DISTANCE = LOD_HYSTERESIS / 4.0;
+
+    bool lod_enabled = true;
+    LodDistances lod_distances = DEFAULT_LOD_DISTANCES;
+    math::Vector3d lod_update_position;
+    bool lod_update_needed = true;
+    std::vector<math::Vector3i64> lod_changes;
+
+    FrameStats frame_stats;
+    GpuProfiler gpu_profiler;
+
+    // Camera-relative section offsets indexed by slot, read by the vertex shader as a buffer texture.
+    GLuint section_offset_buffer = 0;
+    GLuint section_offset_texture = 0;
+    std::vector<GLfloat> section_offsets;
+
+    // Level of detail remeshes reuse the culling data the section already has.
+    void request_mesh(const math::Vector3i64& section, bool lod_only = false);
+    void remesh_all();
+    unsigned select_lod(const math::Vector3i64& section, unsigned current) const;
+    // Returns how many sections were sent back to be remeshed.
+    size_t update_lods();
+    void upload_finished_meshes();
+    void upload_frame_data();
+    void find_cave_visible_sections();
+    size_t get_cave_grid_index(const math::Vector3i64& section) const;
+    bool is_cave_visible(const math::Vector3i64& section) const;
+    void rasterize_occluders();
+    void cull_chunks();
+    void draw_chunks();
 
 public:
-    Renderer();
+    explicit Renderer(World& world);
     ~Renderer() noexcept;
-    void draw();
+
+    // Renders the world into the currently bound framebuffer, which is width by height pixels.
+    void draw(int width, int height);
+
+    Camera& get_camera() { return camera; }
+
+    ChunkMesher::Mode get_mesher_mode() const { return mesher_mode; }
+    // Switching modes remeshes every section.
+    void set_mesher_mode(ChunkMesher::Mode mode);
+
+    bool is_cave_culling() const { return cave_culling; }
+    void set_cave_culling(bool enabled) { cave_culling = enabled; }
+
+    bool is_occlusion_culling() const { return occlusion_culling; }
+    void set_occlusion_culling(bool enabled) { occlusion_culling = enabled; }
+
+    // Sections switch level as the camera moves; disabling meshes everything at full detail.
+    bool is_lod_enabled() const { return lod_enabled; }
+    void set_lod_enabled(bool enabled);
+
+    const LodDistances& get_lod_distances() const { return lod_distances; }
+    // Distances must be strictly increasing.
+    void set_lod_distances(const LodDistances& distances);
+
+    bool has_pending_meshes() const { return pending_meshes != 0; }
+    // Remeshes every section whose level of detail no longer suits the camera, and blocks until
+    // that and any other pending mesh is uploaded, so the next draw has no meshing left to do.
+    // Returns how many sections changed level.
+    size_t sync_meshes();
+
+    const FrameStats& get_frame_stats() const { return frame_stats; }
+    // GPU time of the "total", "clear" and "terrain" passes.
+    const GpuProfiler& get_gpu_profiler() const { return gpu_profiler; }
+
+    // GL calls made during the last complete frame.
+    const GLState::Counters& get_frame_counters() const { return gl_state.get_frame_counters(); }
 };
\ No newline at end of file
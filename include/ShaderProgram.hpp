@@ -1,12 +1,30 @@
 #pragma once
 
+#include <cstddef>
 #include <initializer_list>
+#include <string>
+#include <string_view>
 
 #include "gfx.hpp"
 #include "Shader.hpp"
+#include "StringMap.hpp"
+#include "math/Matrix.hpp"
+#include "math/Vector.hpp"
 
 class ShaderProgram {
 public:
+    struct Uniform {
+        GLint location = -1;
+        GLenum type = 0;
+        // Element count for arrays, 1 otherwise.
+        GLint size = 0;
+    };
+
+    struct UniformBlock {
+        GLuint index = GL_INVALID_INDEX;
+        GLint data_size = 0;
+    };
+
     ShaderProgram();
     ~ShaderProgram() noexcept;
 
@@ -14,11 +32,30 @@ public:
     ShaderProgram& operator=(const ShaderProgram&) = delete;
 
     void attach_shader(Shader&& shader);
+    // Links and reflects every active uniform and uniform block, so nothing is looked up by name
+    // in the driver afterwards.
     void link();
-    void use();
 
-    GLint get_handle() { return shader_program_handle; }
+    GLuint get_handle() const { return shader_program_handle; }
+
+    const Uniform* find_uniform(std::string_view name) const;
+    const UniformBlock* find_uniform_block(std::string_view name) const;
+
+    // The setters write to the program currently in use. Names the linker optimised away are
+    // ignored, the same way GL ignores location -1.
+    void set_uniform(std::string_view name, GLint value);
+    void set_uniform(std::string_view name, GLfloat value);
+    void set_uniform(std::string_view name, const math::Vector3f& value);
+    void set_uniform(std::string_view name, const math::Vector4f& value);
+    void set_uniform(std::string_view name, const math::Matrix4f& value);
+
+    void bind_uniform_block(std::string_view name, GLuint binding);
 
 private:
     GLuint shader_program_handle = 0;
+    StringMap<Uniform> uniforms;
+    StringMap<UniformBlock> uniform_blocks;
+
+    void reflect();
+    const Uniform* find_uniform(std::string_view name, GLenum type) const;
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Hashes through std::string_view, so maps keyed by std::string can be searched with a view or a
+// literal without building a temporary string.
+struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+};
+
+template <typename T>
+using StringMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "gfx.hpp"
+#include "GLState.hpp"
+#include "BufferAllocator.hpp"
+#include "ChunkMesher.hpp"
+
+// Every terrain mesh lives in one vertex buffer behind a single VAO. Meshes are sub-allocated
+// ranges drawn with base-vertex offsets, and their handles stay valid while growth and
+// defragmentation move the ranges around. Meshes are made of quads only, so they all share one
+// static 16-bit index buffer; larger meshes are drawn in batches of QUADS_PER_DRAW.
+class TerrainBuffer {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle INVALID_HANDLE = std::numeric_limits<Handle>::max();
+
+    static constexpr size_t QUADS_PER_DRAW = (size_t(1) << 16) / 4;
+
+    struct Range {
+        size_t vertex_offset = 0;
+        size_t vertex_count = 0;
+    };
+
+    TerrainBuffer(GLState& gl_state, size_t vertex_capacity);
+    ~TerrainBuffer() noexcept;
+
+    TerrainBuffer(const TerrainBuffer&) = delete;
+    TerrainBuffer& operator=(const TerrainBuffer&) = delete;
+
+    Handle allocate(const ChunkMeshData& data);
+    void free(Handle handle);
+
+    // Packs every live range to the front of the buffer, closing the holes left by free.
+    void defragment();
+
+    const Range& get_range(Handle handle) const;
+
+    void bind();
+    // Draws all the given meshes with one multi-draw call; expects bind() to have been called.
+    void draw(std::span<const Handle> handles);
+
+    bool has_indirect_draw() const { return multi_draw_elements_indirect != nullptr; }
+
+    size_t get_vertex_capacity() const { return vertex_allocator.get_capacity(); }
+    size_t get_used_vertices() const { return vertex_allocator.get_capacity() - vertex_allocator.get_free_size(); }
+
+private:
+    GLState& gl_state;
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+    GLuint quad_index_buffer = 0;
+    BufferAllocator vertex_allocator;
+
+    // Matches DrawElementsIndirectCommand from GL_ARB_draw_indirect.
+    struct IndirectCommand {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first_index;
+        GLint base_vertex;
+        GLuint base_instance;
+    };
+
+    using MultiDrawElementsIndirect = void (APIENTRYP)(GLenum mode, GLenum type, const void* indirect, GLsizei draw_count, GLsizei stride);
+
+    // Only loaded when GL_ARB_multi_draw_indirect is available; glad is generated for plain 3.3.
+    MultiDrawElementsIndirect multi_draw_elements_indirect = nullptr;
+    GLuint indirect_buffer = 0;
+    std::vector<IndirectCommand> indirect_commands;
+
+    std::vector<GLsizei> draw_counts;
+    std::vector<const void*> draw_offsets;
+    std::vector<GLint> draw_base_vertices;
+
+    std::vector<Range> ranges;
+    std::vector<uint8_t> live;
+    std::vector<Handle> free_handles;
+
+    void replace_buffer(size_t vertex_capacity);
+    void bind_buffers();
+};
\ No newline at end of file
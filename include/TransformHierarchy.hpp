@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "math/Matrix.hpp"
+
+// Parent/child transforms kept in flat arrays ordered by depth, so every parent is updated before
+// its children and world matrices are refreshed in a single forward pass over dirty entries.
+class TransformHierarchy {
+public:
+    using Node = uint32_t;
+    static constexpr Node NO_PARENT = std::numeric_limits<Node>::max();
+
+    Node add(const math::Matrix4f& local, Node parent = NO_PARENT);
+    void remove(Node node);
+    void clear();
+
+    void set_local(Node node, const math::Matrix4f& local);
+    const math::Matrix4f& get_local(Node node) const;
+    const math::Matrix4f& get_world(Node node) const;
+    Node get_parent(Node node) const;
+
+    void update();
+
+    size_t size() const { return parents.size(); }
+
+private:
+    static constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+    // Per slot, in depth order; parents hold slot indices.
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> depths;
+    std::vector<uint8_t> dirty;
+    std::vector<math::Matrix4f> locals;
+    std::vector<math::Matrix4f> worlds;
+    std::vector<Node> slot_nodes;
+
+    // Node handles stay valid while slots move around.
+    std::vector<uint32_t> node_slots;
+    std::vector<Node> free_nodes;
+
+    bool any_dirty = false;
+    bool unsorted = false;
+
+    void sort_by_depth();
+    void apply_order(const std::vector<uint32_t>& order);
+};
\ No newline at end of file
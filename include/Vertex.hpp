@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+#include "gfx.hpp"
+
+// Terrain vertex packed into two integers, unpacked in shaders/vertex.glsl:
+//   data[0]: x (6 bits) | y (6) | z (6) | face (3) | ambient occlusion (2) | light (4) | lod (2), bits 29..31 unused
+//   data[1]: texture layer (16) | section slot (16)
+// Positions are section-local corners, so 0..32 inclusive fits in 6 bits; level of detail meshes
+// store them in units of 2^lod blocks. The slot picks the section's camera-relative offset out of
+// a buffer texture, so one multi-draw covers all sections.
+struct Vertex {
+    static constexpr unsigned POSITION_BITS = 6;
+    static constexpr unsigned FACE_SHIFT = 3 * POSITION_BITS;
+    static constexpr unsigned AO_SHIFT = FACE_SHIFT + 3;
+    static constexpr unsigned LIGHT_SHIFT = AO_SHIFT + 2;
+    static constexpr unsigned LOD_SHIFT = LIGHT_SHIFT + 4;
+    static constexpr unsigned SLOT_SHIFT = 16;
+
+    static constexpr uint32_t MAX_AO = 3;
+    static constexpr uint32_t MAX_LIGHT = 15;
+    static constexpr uint32_t MAX_LOD = 3;
+    static constexpr uint32_t MAX_SLOT = 0xFFFF;
+
+    GLuint data[2];
+
+    static constexpr Vertex pack(uint32_t x, uint32_t y, uint32_t z, uint32_t face, uint32_t ao, uint32_t light, uint32_t layer) {
+        return Vertex {{
+            x | (y << POSITION_BITS) | (z << (2 * POSITION_BITS)) | (face << FACE_SHIFT) | (ao << AO_SHIFT) | (light << LIGHT_SHIFT),
+            layer
+        }};
+    }
+};
+
+static_assert(sizeof(Vertex) == 8);
\ No newline at end of file
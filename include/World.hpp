@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "Block.hpp"
+#include "ChunkSection.hpp"
+#include "math/Vector.hpp"
+
+class World {
+public:
+    static constexpr int64_t MIN_SECTION_Y = 0;
+    static constexpr int64_t MAX_SECTION_Y = 3;
+
+    void generate(int64_t center_x, int64_t center_z, int64_t radius);
+
+    ChunkSection* get_section(const math::Vector3i64& section);
+    const ChunkSection* get_section(const math::Vector3i64& section) const;
+    ChunkSection& get_or_create_section(const math::Vector3i64& section);
+
+    Block get_block(const math::Vector3i64& position) const;
+    void set_block(const math::Vector3i64& position, Block block);
+
+    const std::unordered_map<uint64_t, std::unique_ptr<ChunkSection>>& get_sections() const { return sections; }
+
+private:
+    std::unordered_map<uint64_t, std::unique_ptr<ChunkSection>> sections;
+
+    void generate_column(int64_t section_x, int64_t section_z);
+};
\ No newline at end of file
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+#include "math/Matrix.hpp"
+#include "math/Vector.hpp"
+#include "math/Quaternion.hpp"
+
+namespace math {
+    // A 4x4 transform whose last row is implicitly (0, 0, 0, 1), stored as four column-major
+    // columns of three: the linear part followed by the translation.
+    template <typename T>
+    struct Affine3 {
+    public:
+        static constexpr size_t SIZE = 12;
+
+        constexpr Affine3() = default;
+
+        template <typename... Args>
+        requires (sizeof...(Args) == SIZE && (std::is_same_v<T, Args> && ...))
+        constexpr Affine3(Args... args) : array{args...} {}
+
+        static constexpr Affine3 from_translation(const Vector<T, 3>& offset) {
+            Affine3 result;
+            result.array[9] = offset.x();
+            result.array[10] = offset.y();
+            result.array[11] = offset.z();
+            return result;
+        }
+
+        static constexpr Affine3 from_scale(const Vector<T, 3>& scale) {
+            Affine3 result;
+            result.array[0] = scale.x();
+            result.array[4] = scale.y();
+            result.array[8] = scale.z();
+            return result;
+        }
+
+        static constexpr Affine3 from_rotation(const Quaternion<T>& rotation) {
+            Matrix<T, 4, 4> matrix = rotation.to_matrix();
+            Affine3 result;
+            for (size_t column = 0; column < 3; ++column) {
+                for (size_t row = 0; row < 3; ++row) {
+                    result.array[column * 3 + row] = matrix[column][row];
+                }
+            }
+
+            return result;
+        }
+
+        static constexpr Affine3 from_rotation_translation(const Quaternion<T>& rotation, const Vector<T, 3>& offset) {
+            Affine3 result = from_rotation(rotation);
+            result.array[9] = offset.x();
+            result.array[10] = offset.y();
+            result.array[11] = offset.z();
+            return result;
+        }
+
+        constexpr std::span<T, 3> operator[](size_t column_index) {
+            assert(column_index < 4);
+            return std::span<T, 3>(array.data() + column_index * 3, 3);
+        }
+
+        constexpr std::span<const T, 3> operator[](size_t column_index) const {
+            assert(column_index < 4);
+            return std::span<const T, 3>(array.data() + column_index * 3, 3);
+        }
+
+        constexpr Affine3 operator*(const Affine3& rhs) const {
+            const std::array<T, SIZE>& a = array;
+            const std::array<T, SIZE>& b = rhs.array;
+
+            return Affine3 {
+                a[0] * b[0] + a[3] * b[1] + a[6] * b[2],
+                a[1] * b[0] + a[4] * b[1] + a[7] * b[2],
+                a[2] * b[0] + a[5] * b[1] + a[8] * b[2],
+                a[0] * b[3] + a[3] * b[4] + a[6] * b[5],
+                a[1] * b[3] + a[4] * b[4] + a[7] * b[5],
+                a[2] * b[3] + a[5] * b[4] + a[8] * b[5],
+                a[0] * b[6] + a[3] * b[7] + a[6] * b[8],
+                a[1] * b[6] + a[4] * b[7] + a[7] * b[8],
+                a[2] * b[6] + a[5] * b[7] + a[8] * b[8],
+                a[0] * b[9] + a[3] * b[10] + a[6] * b[11] + a[9],
+                a[1] * b[9] + a[4] * b[10] + a[7] * b[11] + a[10],
+                a[2] * b[9] + a[5] * b[10] + a[8] * b[11] + a[11]
+            };
+        }
+
+        constexpr bool operator==(const Affine3& rhs) const {
+            return array == rhs.array;
+        }
+
+        constexpr Vector<T, 3> transform_point(const Vector<T, 3>& point) const {
+            return Vector<T, 3>(
+                array[0] * point.x() + array[3] * point.y() + array[6] * point.z() + array[9],
+                array[1] * point.x() + array[4] * point.y() + array[7] * point.z() + array[10],
+                array[2] * point.x() + array[5] * point.y() + array[8] * point.z() + array[11]
+            );
+        }
+
+        constexpr Vector<T, 3> transform_vector(const Vector<T, 3>& vector) const {
+            return Vector<T, 3>(
+                array[0] * vector.x() + array[3] * vector.y() + array[6] * vector.z(),
+                array[1] * vector.x() + array[4] * vector.y() + array[7] * vector.z(),
+                array[2] * vector.x() + array[5] * vector.y() + array[8] * vector.z()
+            );
+        }
+
+        constexpr Vector<T, 3> get_translation() const {
+            return Vector<T, 3>(array[9], array[10], array[11]);
+        }
+
+        // Inverse of the 3x3 part by cofactors, then the translation is rotated back through it.
+        // The linear part must not be singular.
+        constexpr Affine3 inverse() const {
+            const T* m = array.data();
+
+            T c00 = m[4] * m[8] - m[7] * m[5];
+            T c01 = m[7] * m[2] - m[1] * m[8];
+            T c02 = m[1] * m[5] - m[4] * m[2];
+            T determinant = m[0] * c00 + m[3] * c01 + m[6] * c02;
+            assert(determinant != T(0));
+
+            T inverse_determinant = T(1) / determinant;
+
+            Affine3 result;
+            T* r = result.array.data();
+            r[0] = c00 * inverse_determinant;
+            r[1] = c01 * inverse_determinant;
+            r[2] = c02 * inverse_determinant;
+            r[3] = (m[6] * m[5] - m[3] * m[8]) * inverse_determinant;
+            r[4] = (m[0] * m[8] - m[6] * m[2]) * inverse_determinant;
+            r[5] = (m[3] * m[2] - m[0] * m[5]) * inverse_determinant;
+            r[6] = (m[3] * m[7] - m[6] * m[4]) * inverse_determinant;
+            r[7] = (m[6] * m[1] - m[0] * m[7]) * inverse_determinant;
+            r[8] = (m[0] * m[4] - m[3] * m[1]) * inverse_determinant;
+            r[9] = -(r[0] * m[9] + r[3] * m[10] + r[6] * m[11]);
+            r[10] = -(r[1] * m[9] + r[4] * m[10] + r[7] * m[11]);
+            r[11] = -(r[2] * m[9] + r[5] * m[10] + r[8] * m[11]);
+            return result;
+        }
+
+        // Only valid when the linear part is a pure rotation: its inverse is then its transpose.
+        constexpr Affine3 inverse_rigid() const {
+            const T* m = array.data();
+
+            Affine3 result;
+            T* r = result.array.data();
+            r[0] = m[0]; r[1] = m[3]; r[2] = m[6];
+            r[3] = m[1]; r[4] = m[4]; r[5] = m[7];
+            r[6] = m[2]; r[7] = m[5]; r[8] = m[8];
+            r[9] = -(r[0] * m[9] + r[3] * m[10] + r[6] * m[11]);
+            r[10] = -(r[1] * m[9] + r[4] * m[10] + r[7] * m[11]);
+            r[11] = -(r[2] * m[9] + r[5] * m[10] + r[8] * m[11]);
+            return result;
+        }
+
+        explicit constexpr operator Matrix<T, 4, 4>() const {
+            return Matrix<T, 4, 4> {
+                array[0], array[1], array[2], T(0),
+                array[3], array[4], array[5], T(0),
+                array[6], array[7], array[8], T(0),
+                array[9], array[10], array[11], T(1)
+            };
+        }
+
+        constexpr const T* data() const {
+            return array.data();
+        }
+
+    private:
+        std::array<T, SIZE> array = {
+            T(1), T(0), T(0),
+            T(0), T(1), T(0),
+            T(0), T(0), T(1),
+            T(0), T(0), T(0)
+        };
+    };
+
+    using Affine3f = Affine3<float>;
+}
\ No newline at end of file
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <cassert>
+#include <span>
+#include <type_traits>
+
+#include "math/simd.hpp"
+#include "math/Matrix.hpp"
+
+namespace math {
+    template <typename T>
+    struct PointStreams {
+        std::span<T> x;
+        std::span<T> y;
+        std::span<T> z;
+
+        constexpr size_t size() const {
+            assert(x.size() == y.size() && x.size() == z.size());
+            return x.size();
+        }
+
+        constexpr operator PointStreams<const T>() const requires (!std::is_const_v<T>) {
+            return {x, y, z};
+        }
+    };
+
+    template <typename T>
+    struct AABBStreams {
+        PointStreams<T> min;
+        PointStreams<T> max;
+
+        constexpr size_t size() const {
+            assert(min.size() == max.size());
+            return min.size();
+        }
+
+        constexpr operator AABBStreams<const T>() const requires (!std::is_const_v<T>) {
+            return {min, max};
+        }
+    };
+
+    // Transforms points with w = 1 and drops the projective row, so the matrix should be affine.
+    inline void transform_points(const Matrix4f& matrix, PointStreams<const float> points, PointStreams<float> result) {
+        size_t count = points.size();
+        assert(result.size() >= count);
+
+        const float* m = matrix.data();
+        size_t i = 0;
+
+#if defined(MATH_SIMD_SSE)
+        simd::WideFloat m00 = simd::splat(m[0]), m01 = simd::splat(m[1]), m02 = simd::splat(m[2]);
+        simd::WideFloat m10 = simd::splat(m[4]), m11 = simd::splat(m[5]), m12 = simd::splat(m[6]);
+        simd::WideFloat m20 = simd::splat(m[8]), m21 = simd::splat(m[9]), m22 = simd::splat(m[10]);
+        simd::WideFloat m30 = simd::splat(m[12]), m31 = simd::splat(m[13]), m32 = simd::splat(m[14]);
+
+        for (; i + simd::WIDTH <= count; i += simd::WIDTH) {
+            simd::WideFloat x = simd::load_wide(points.x.data() + i);
+            simd::WideFloat y = simd::load_wide(points.y.data() + i);
+            simd::WideFloat z = simd::load_wide(points.z.data() + i);
+
+            simd::store_wide(result.x.data() + i, simd::multiply_add(m00, x, simd::multiply_add(m10, y, simd::multiply_add(m20, z, m30))));
+            simd::store_wide(result.y.data() + i, simd::multiply_add(m01, x, simd::multiply_add(m11, y, simd::multiply_add(m21, z, m31))));
+            simd::store_wide(result.z.data() + i, simd::multiply_add(m02, x, simd::multiply_add(m12, y, simd::multiply_add(m22, z, m32))));
+        }
+#endif
+
+        for (; i < count; ++i) {
+            float x = points.x[i], y = points.y[i], z = points.z[i];
+            result.x[i] = m[0] * x + m[4] * y + m[8] * z + m[12];
+            result.y[i] = m[1] * x + m[5] * y + m[9] * z + m[13];
+            result.z[i] = m[2] * x + m[6] * y + m[10] * z + m[14];
+        }
+    }
+
+    // Transforms points with w = 1 into homogeneous clip space, without the perspective divide.
+    inline void project_points(const Matrix4f& matrix, PointStreams<const float> points, PointStreams<float> result, std::span<float> result_w) {
+        size_t count = points.size();
+        assert(result.size() >= count && result_w.size() >= count);
+
+        const float* m = matrix.data();
+        size_t i = 0;
+
+#if defined(MATH_SIMD_SSE)
+        simd::WideFloat m00 = simd::splat(m[0]), m01 = simd::splat(m[1]), m02 = simd::splat(m[2]), m03 = simd::splat(m[3]);
+        simd::WideFloat m10 = simd::splat(m[4]), m11 = simd::splat(m[5]), m12 = simd::splat(m[6]), m13 = simd::splat(m[7]);
+        simd::WideFloat m20 = simd::splat(m[8]), m21 = simd::splat(m[9]), m22 = simd::splat(m[10]), m23 = simd::splat(m[11]);
+        simd::WideFloat m30 = simd::splat(m[12]), m31 = simd::splat(m[13]), m32 = simd::splat(m[14]), m33 = simd::splat(m[15]);
+
+        for (; i + simd::WIDTH <= count; i += simd::WIDTH) {
+            simd::WideFloat x = simd::load_wide(points.x.data() + i);
+            simd::WideFloat y = simd::load_wide(points.y.data() + i);
+            simd::WideFloat z = simd::load_wide(points.z.data() + i);
+
+            simd::store_wide(result.x.data() + i, simd::multiply_add(m00, x, simd::multiply_add(m10, y, simd::multiply_add(m20, z, m30))));
+            simd::store_wide(result.y.data() + i, simd::multiply_add(m01, x, simd::multiply_add(m11, y, simd::multiply_add(m21, z, m31))));
+            simd::store_wide(result.z.data() + i, simd::multiply_add(m02, x, simd::multiply_add(m12, y, simd::multiply_add(m22, z, m32))));
+            simd::store_wide(result_w.data() + i, simd::multiply_add(m03, x, simd::multiply_add(m13, y, simd::multiply_add(m23, z, m33))));
+        }
+#endif
+
+        for (; i < count; ++i) {
+            float x = points.x[i], y = points.y[i], z = points.z[i];
+            result.x[i] = m[0] * x + m[4] * y + m[8] * z + m[12];
+            result.y[i] = m[1] * x + m[5] * y + m[9] * z + m[13];
+            result.z[i] = m[2] * x + m[6] * y + m[10] * z + m[14];
+            result_w[i] = m[3] * x + m[7] * y + m[11] * z + m[15];
+        }
+    }
+
+    // Transforms boxes by an affine matrix and writes the tightest axis-aligned box around each of the
+    // eight transformed corners, using the center/extent form so no corner is expanded explicitly.
+    inline void transform_aabbs(const Matrix4f& matrix, AABBStreams<const float> boxes, AABBStreams<float> result) {
+        size_t count = boxes.size();
+        assert(result.size() >= count);
+
+        const float* m = matrix.data();
+        size_t i = 0;
+
+#if defined(MATH_SIMD_SSE)
+        simd::WideFloat m00 = simd::splat(m[0]), m01 = simd::splat(m[1]), m02 = simd::splat(m[2]);
+        simd::WideFloat m10 = simd::splat(m[4]), m11 = simd::splat(m[5]), m12 = simd::splat(m[6]);
+        simd::WideFloat m20 = simd::splat(m[8]), m21 = simd::splat(m[9]), m22 = simd::splat(m[10]);
+        simd::WideFloat m30 = simd::splat(m[12]), m31 = simd::splat(m[13]), m32 = simd::splat(m[14]);
+        simd::WideFloat a00 = simd::abs(m00), a01 = simd::abs(m01), a02 = simd::abs(m02);
+        simd::WideFloat a10 = simd::abs(m10), a11 = simd::abs(m11), a12 = simd::abs(m12);
+        simd::WideFloat a20 = simd::abs(m20), a21 = simd::abs(m21), a22 = simd::abs(m22);
+        simd::WideFloat half = simd::splat(0.5f);
+
+        for (; i + simd::WIDTH <= count; i += simd::WIDTH) {
+            simd::WideFloat min_x = simd::load_wide(boxes.min.x.data() + i);
+            simd::WideFloat min_y = simd::load_wide(boxes.min.y.data() + i);
+            simd::WideFloat min_z = simd::load_wide(boxes.min.z.data() + i);
+            simd::WideFloat max_x = simd::load_wide(boxes.max.x.data() + i);
+            simd::WideFloat max_y = simd::load_wide(boxes.max.y.data() + i);
+            simd::WideFloat max_z = simd::load_wide(boxes.max.z.data() + i);
+
+            simd::WideFloat center_x = simd::mul(simd::add(min_x, max_x), half);
+            simd::WideFloat center_y = simd::mul(simd::add(min_y, max_y), half);
+            simd::WideFloat center_z = simd::mul(simd::add(min_z, max_z), half);
+            simd::WideFloat extent_x = simd::mul(simd::sub(max_x, min_x), half);
+            simd::WideFloat extent_y = simd::mul(simd::sub(max_y, min_y), half);
+            simd::WideFloat extent_z = simd::mul(simd::sub(max_z, min_z), half);
+
+            simd::WideFloat x = simd::multiply_add(m00, center_x, simd::multiply_add(m10, center_y, simd::multiply_add(m20, center_z, m30)));
+            simd::WideFloat y = simd::multiply_add(m01, center_x, simd::multiply_add(m11, center_y, simd::multiply_add(m21, center_z, m31)));
+            simd::WideFloat z = simd::multiply_add(m02, center_x, simd::multiply_add(m12, center_y, simd::multiply_add(m22, center_z, m32)));
+            simd::WideFloat ex = simd::multiply_add(a00, extent_x, simd::multiply_add(a10, extent_y, simd::mul(a20, extent_z)));
+            simd::WideFloat ey = simd::multiply_add(a01, extent_x, simd::multiply_add(a11, extent_y, simd::mul(a21, extent_z)));
+            simd::WideFloat ez = simd::multiply_add(a02, extent_x, simd::multiply_add(a12, extent_y, simd::mul(a22, extent_z)));
+
+            simd::store_wide(result.min.x.data() + i, simd::sub(x, ex));
+            simd::store_wide(result.min.y.data() + i, simd::sub(y, ey));
+            simd::store_wide(result.min.z.data() + i, simd::sub(z, ez));
+            simd::store_wide(result.max.x.data() + i, simd::add(x, ex));
+            simd::store_wide(result.max.y.data() + i, simd::add(y, ey));
+            simd::store_wide(result.max.z.data() + i, simd::add(z, ez));
+        }
+#endif
+
+        for (; i < count; ++i) {
+            float center_x = (boxes.min.x[i] + boxes.max.x[i]) * 0.5f;
+            float center_y = (boxes.min.y[i] + boxes.max.y[i]) * 0.5f;
+            float center_z = (boxes.min.z[i] + boxes.max.z[i]) * 0.5f;
+            float extent_x = (boxes.max.x[i] - boxes.min.x[i]) * 0.5f;
+            float extent_y = (boxes.max.y[i] - boxes.min.y[i]) * 0.5f;
+            float extent_z = (boxes.max.z[i] - boxes.min.z[i]) * 0.5f;
+
+            float x = m[0] * center_x + m[4] * center_y + m[8] * center_z + m[12];
+            float y = m[1] * center_x + m[5] * center_y + m[9] * center_z + m[13];
+            float z = m[2] * center_x + m[6] * center_y + m[10] * center_z + m[14];
+            float ex = std::abs(m[0]) * extent_x + std::abs(m[4]) * extent_y + std::abs(m[8]) * extent_z;
+            float ey = std::abs(m[1]) * extent_x + std::abs(m[5]) * extent_y + std::abs(m[9]) * extent_z;
+            float ez = std::abs(m[2]) * extent_x + std::abs(m[6]) * extent_y + std::abs(m[10]) * extent_z;
+
+            result.min.x[i] = x - ex;
+            result.min.y[i] = y - ey;
+            result.min.z[i] = z - ez;
+            result.max.x[i] = x + ex;
+            result.max.y[i] = y + ey;
+            result.max.z[i] = z + ez;
+        }
+    }
+}
\ No newline at end of file
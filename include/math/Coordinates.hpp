@@ -0,0 +1,142 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "math/Vector.hpp"
+
+#if defined(__BMI2__)
+    #include <immintrin.h>
+#endif
+
+namespace math {
+    // C++20 defines >> on negative values as an arithmetic shift, which is exactly floor division
+    // by a power of two; masking the low bits gives the matching non-negative remainder.
+    template <std::signed_integral T>
+    constexpr T floor_div_pow2(T value, unsigned shift) {
+        return value >> shift;
+    }
+
+    template <std::signed_integral T>
+    constexpr T floor_mod_pow2(T value, unsigned shift) {
+        return value & ((T(1) << shift) - 1);
+    }
+
+    template <std::signed_integral T, size_t SIZE>
+    constexpr Vector<T, SIZE> floor_div_pow2(const Vector<T, SIZE>& value, unsigned shift) {
+        Vector<T, SIZE> result;
+        for (size_t i = 0; i < SIZE; ++i) {
+            result[i] = floor_div_pow2(value[i], shift);
+        }
+
+        return result;
+    }
+
+    template <std::signed_integral T, size_t SIZE>
+    constexpr Vector<T, SIZE> floor_mod_pow2(const Vector<T, SIZE>& value, unsigned shift) {
+        Vector<T, SIZE> result;
+        for (size_t i = 0; i < SIZE; ++i) {
+            result[i] = floor_mod_pow2(value[i], shift);
+        }
+
+        return result;
+    }
+
+    // Chunk keys hold three signed 21-bit coordinates, enough for +-1M chunks on every axis.
+    inline constexpr unsigned CHUNK_KEY_BITS = 21;
+
+    constexpr uint64_t pack_chunk_key(const Vector3i64& chunk) {
+        constexpr uint64_t mask = (uint64_t(1) << CHUNK_KEY_BITS) - 1;
+        return (static_cast<uint64_t>(chunk.x()) & mask)
+            | ((static_cast<uint64_t>(chunk.y()) & mask) << CHUNK_KEY_BITS)
+            | ((static_cast<uint64_t>(chunk.z()) & mask) << (2 * CHUNK_KEY_BITS));
+    }
+
+    constexpr Vector3i64 unpack_chunk_key(uint64_t key) {
+        // Shift each field to the top, then shift back arithmetically to sign-extend it.
+        constexpr unsigned top = 64 - CHUNK_KEY_BITS;
+        return Vector3i64(
+            static_cast<int64_t>(key << top) >> top,
+            static_cast<int64_t>(key << (top - CHUNK_KEY_BITS)) >> top,
+            static_cast<int64_t>(key << (top - 2 * CHUNK_KEY_BITS)) >> top
+        );
+    }
+
+    constexpr uint32_t morton_spread3(uint32_t value) {
+        value &= 0x000003FF;
+        value = (value | (value << 16)) & 0x030000FF;
+        value = (value | (value << 8)) & 0x0300F00F;
+        value = (value | (value << 4)) & 0x030C30C3;
+        value = (value | (value << 2)) & 0x09249249;
+        return value;
+    }
+
+    constexpr uint32_t morton_compact3(uint32_t value) {
+        value &= 0x09249249;
+        value = (value | (value >> 2)) & 0x030C30C3;
+        value = (value | (value >> 4)) & 0x0300F00F;
+        value = (value | (value >> 8)) & 0x030000FF;
+        value = (value | (value >> 16)) & 0x000003FF;
+        return value;
+    }
+
+    constexpr uint64_t morton_spread3(uint64_t value) {
+        value &= 0x00000000001FFFFF;
+        value = (value | (value << 32)) & 0x001F00000000FFFF;
+        value = (value | (value << 16)) & 0x001F0000FF0000FF;
+        value = (value | (value << 8)) & 0x100F00F00F00F00F;
+        value = (value | (value << 4)) & 0x10C30C30C30C30C3;
+        value = (value | (value << 2)) & 0x1249249249249249;
+        return value;
+    }
+
+    constexpr uint64_t morton_compact3(uint64_t value) {
+        value &= 0x1249249249249249;
+        value = (value | (value >> 2)) & 0x10C30C30C30C30C3;
+        value = (value | (value >> 4)) & 0x100F00F00F00F00F;
+        value = (value | (value >> 8)) & 0x001F0000FF0000FF;
+        value = (value | (value >> 16)) & 0x001F00000000FFFF;
+        value = (value | (value >> 32)) & 0x00000000001FFFFF;
+        return value;
+    }
+
+    // 10 bits per axis, x in the lowest bit of each triple.
+    constexpr uint32_t morton_encode(uint32_t x, uint32_t y, uint32_t z) {
+#if defined(__BMI2__)
+        if (!std::is_constant_evaluated()) {
+            return _pdep_u32(x, 0x09249249) | _pdep_u32(y, 0x12492492) | _pdep_u32(z, 0x24924924);
+        }
+#endif
+
+        return morton_spread3(x) | (morton_spread3(y) << 1) | (morton_spread3(z) << 2);
+    }
+
+    constexpr Vector3i morton_decode(uint32_t code) {
+        return Vector3i(
+            static_cast<int32_t>(morton_compact3(code)),
+            static_cast<int32_t>(morton_compact3(code >> 1)),
+            static_cast<int32_t>(morton_compact3(code >> 2))
+        );
+    }
+
+    // 21 bits per axis.
+    constexpr uint64_t morton_encode(uint64_t x, uint64_t y, uint64_t z) {
+#if defined(__BMI2__) && defined(__x86_64__)
+        if (!std::is_constant_evaluated()) {
+            return _pdep_u64(x, 0x1249249249249249) | _pdep_u64(y, 0x2492492492492492) | _pdep_u64(z, 0x4924924924924924);
+        }
+#endif
+
+        return morton_spread3(x) | (morton_spread3(y) << 1) | (morton_spread3(z) << 2);
+    }
+
+    constexpr Vector3i64 morton_decode(uint64_t code) {
+        return Vector3i64(
+            static_cast<int64_t>(morton_compact3(code)),
+            static_cast<int64_t>(morton_compact3(code >> 1)),
+            static_cast<int64_t>(morton_compact3(code >> 2))
+        );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <cassert>
+
+#include "math/simd.hpp"
+#include "math/Batch.hpp"
+#include "math/Matrix.hpp"
+#include "math/Vector.hpp"
+
+namespace math {
+    enum class Containment : uint8_t {
+        Outside,
+        Intersecting,
+        Inside
+    };
+
+    struct Plane {
+        Vector3f normal;
+        float distance = 0.0f;
+
+        constexpr float signed_distance(const Vector3f& point) const {
+            return normal.x() * point.x() + normal.y() * point.y() + normal.z() * point.z() + distance;
+        }
+    };
+
+    class Frustum {
+    public:
+        enum Side : size_t {
+            Left,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            SIDE_COUNT
+        };
+
+        constexpr Frustum() = default;
+
+        // Gribb-Hartmann extraction; the planes face inwards and are normalized so sphere radii
+        // can be compared against them directly.
+        static Frustum from_matrix(const Matrix4f& matrix) {
+            auto row = [&matrix](size_t index) {
+                return Vector4f(matrix[0][index], matrix[1][index], matrix[2][index], matrix[3][index]);
+            };
+
+            Vector4f x = row(0), y = row(1), z = row(2), w = row(3);
+            std::array<Vector4f, SIDE_COUNT> equations = {w + x, w - x, w + y, w - y, w + z, w - z};
+
+            Frustum frustum;
+            for (size_t i = 0; i < SIDE_COUNT; ++i) {
+                const Vector4f& equation = equations[i];
+                float inverse_length = 1.0f / std::sqrt(
+                    equation.x() * equation.x() + equation.y() * equation.y() + equation.z() * equation.z()
+                );
+
+                frustum.planes[i].normal = Vector3f(equation.x(), equation.y(), equation.z()) * inverse_length;
+                frustum.planes[i].distance = equation.w() * inverse_length;
+            }
+
+            return frustum;
+        }
+
+        const Plane& get_plane(Side side) const {
+            return planes[side];
+        }
+
+        Containment classify_sphere(const Vector3f& center, float radius) const {
+            Containment result = Containment::Inside;
+            for (const Plane& plane : planes) {
+                float distance = plane.signed_distance(center);
+                if (distance < -radius) {
+                    return Containment::Outside;
+                }
+
+                if (distance < radius) {
+                    result = Containment::Intersecting;
+                }
+            }
+
+            return result;
+        }
+
+        Containment classify_aabb(const Vector3f& min, const Vector3f& max) const {
+            Vector3f center = (min + max) * 0.5f;
+            Vector3f extent = (max - min) * 0.5f;
+
+            Containment result = Containment::Inside;
+            for (const Plane& plane : planes) {
+                float distance = plane.signed_distance(center);
+                float radius = std::abs(plane.normal.x()) * extent.x()
+                    + std::abs(plane.normal.y()) * extent.y()
+                    + std::abs(plane.normal.z()) * extent.z();
+
+                if (distance < -radius) {
+                    return Containment::Outside;
+                }
+
+                if (distance < radius) {
+                    result = Containment::Intersecting;
+                }
+            }
+
+            return result;
+        }
+
+        void classify_aabbs(AABBStreams<const float> boxes, std::span<Containment> result) const {
+            size_t count = boxes.size();
+            assert(result.size() >= count);
+
+            size_t i = 0;
+
+#if defined(MATH_SIMD_SSE)
+            simd::WideFloat half = simd::splat(0.5f);
+            simd::WideFloat zero = simd::splat(0.0f);
+
+            for (; i + simd::WIDTH <= count; i += simd::WIDTH) {
+                simd::WideFloat min_x = simd::load_wide(boxes.min.x.data() + i);
+                simd::WideFloat min_y = simd::load_wide(boxes.min.y.data() + i);
+                simd::WideFloat min_z = simd::load_wide(boxes.min.z.data() + i);
+                simd::WideFloat max_x = simd::load_wide(boxes.max.x.data() + i);
+                simd::WideFloat max_y = simd::load_wide(boxes.max.y.data() + i);
+                simd::WideFloat max_z = simd::load_wide(boxes.max.z.data() + i);
+
+                simd::WideFloat center_x = simd::mul(simd::add(min_x, max_x), half);
+                simd::WideFloat center_y = simd::mul(simd::add(min_y, max_y), half);
+                simd::WideFloat center_z = simd::mul(simd::add(min_z, max_z), half);
+                simd::WideFloat extent_x = simd::mul(simd::sub(max_x, min_x), half);
+                simd::WideFloat extent_y = simd::mul(simd::sub(max_y, min_y), half);
+                simd::WideFloat extent_z = simd::mul(simd::sub(max_z, min_z), half);
+
+                simd::WideFloat outside = zero;
+                simd::WideFloat intersecting = zero;
+                for (const Plane& plane : planes) {
+                    simd::WideFloat distance = simd::multiply_add(simd::splat(plane.normal.x()), center_x,
+                        simd::multiply_add(simd::splat(plane.normal.y()), center_y,
+                        simd::multiply_add(simd::splat(plane.normal.z()), center_z, simd::splat(plane.distance))));
+                    simd::WideFloat radius = simd::multiply_add(simd::splat(std::abs(plane.normal.x())), extent_x,
+                        simd::multiply_add(simd::splat(std::abs(plane.normal.y())), extent_y,
+                        simd::mul(simd::splat(std::abs(plane.normal.z())), extent_z)));
+
+                    outside = simd::bit_or(outside, simd::less_than(simd::add(distance, radius), zero));
+                    intersecting = simd::bit_or(intersecting, simd::less_than(distance, radius));
+                }
+
+                unsigned outside_bits = simd::mask_bits(outside);
+                unsigned intersecting_bits = simd::mask_bits(intersecting);
+                for (size_t lane = 0; lane < simd::WIDTH; ++lane) {
+                    if (outside_bits & (1u << lane)) {
+                        result[i + lane] = Containment::Outside;
+                    } else if (intersecting_bits & (1u << lane)) {
+                        result[i + lane] = Containment::Intersecting;
+                    } else {
+                        result[i + lane] = Containment::Inside;
+                    }
+                }
+            }
+#endif
+
+            for (; i < count; ++i) {
+                result[i] = classify_aabb(
+                    Vector3f(boxes.min.x[i], boxes.min.y[i], boxes.min.z[i]),
+                    Vector3f(boxes.max.x[i], boxes.max.y[i], boxes.max.z[i])
+                );
+            }
+        }
+
+        void classify_spheres(PointStreams<const float> centers, std::span<const float> radii, std::span<Containment> result) const {
+            size_t count = centers.size();
+            assert(radii.size() >= count && result.size() >= count);
+
+            size_t i = 0;
+
+#if defined(MATH_SIMD_SSE)
+            simd::WideFloat zero = simd::splat(0.0f);
+
+            for (; i + simd::WIDTH <= count; i += simd::WIDTH) {
+                simd::WideFloat center_x = simd::load_wide(centers.x.data() + i);
+                simd::WideFloat center_y = simd::load_wide(centers.y.data() + i);
+                simd::WideFloat center_z = simd::load_wide(centers.z.data() + i);
+                simd::WideFloat radius = simd::load_wide(radii.data() + i);
+
+                simd::WideFloat outside = zero;
+                simd::WideFloat intersecting = zero;
+                for (const Plane& plane : planes) {
+                    simd::WideFloat distance = simd::multiply_add(simd::splat(plane.normal.x()), center_x,
+                        simd::multiply_add(simd::splat(plane.normal.y()), center_y,
+                        simd::multiply_add(simd::splat(plane.normal.z()), center_z, simd::splat(plane.distance))));
+
+                    outside = simd::bit_or(outside, simd::less_than(simd::add(distance, radius), zero));
+                    intersecting = simd::bit_or(intersecting, simd::less_than(distance, radius));
+                }
+
+                unsigned outside_bits = simd::mask_bits(outside);
+                unsigned intersecting_bits = simd::mask_bits(intersecting);
+                for (size_t lane = 0; lane < simd::WIDTH; ++lane) {
+                    if (outside_bits & (1u << lane)) {
+                        result[i + lane] = Containment::Outside;
+                    } else if (intersecting_bits & (1u << lane)) {
+                        result[i + lane] = Containment::Intersecting;
+                    } else {
+                        result[i + lane] = Containment::Inside;
+                    }
+                }
+            }
+#endif
+
+            for (; i < count; ++i) {
+                result[i] = classify_sphere(Vector3f(centers.x[i], centers.y[i], centers.z[i]), radii[i]);
+            }
+        }
+
+    private:
+        std::array<Plane, SIDE_COUNT> planes = {};
+    };
+}
\ No newline at end of file
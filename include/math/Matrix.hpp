@@ -7,8 +7,11 @@
 #include <array>
 #include <initializer_list>
 #include <ranges>
+#include <type_traits>
 
 #include "math/pi.hpp"
+#include "math/Trig.hpp"
+#include "math/simd.hpp"
 #include "math/Vector.hpp"
 
 namespace math {
@@ -37,6 +40,15 @@ namespace math {
         template <size_t RHS_COLUMN_COUNT>
         constexpr Matrix<T, RHS_COLUMN_COUNT, ROW_COUNT> operator*(const Matrix<T, RHS_COLUMN_COUNT, COLUMN_COUNT>& rhs) const {
             Matrix<T, RHS_COLUMN_COUNT, ROW_COUNT> result;
+#if defined(MATH_SIMD_SSE)
+            if constexpr (std::is_same_v<T, float> && COLUMN_COUNT == 4 && ROW_COUNT == 4 && RHS_COLUMN_COUNT == 4) {
+                if (!std::is_constant_evaluated()) {
+                    simd::multiply_matrix4(array.data(), rhs.array.data(), result.array.data());
+                    return result;
+                }
+            }
+#endif
+
             for (size_t rhs_column = 0; rhs_column < RHS_COLUMN_COUNT; ++rhs_column) {
                 for (size_t row = 0; row < ROW_COUNT; ++row) {
                     for (size_t column = 0; column < COLUMN_COUNT; ++column) {
@@ -50,6 +62,15 @@ namespace math {
 
         constexpr Vector<T, ROW_COUNT> operator*(const Vector<T, COLUMN_COUNT>& rhs) const {
             Vector<T, ROW_COUNT> result;
+#if defined(MATH_SIMD_SSE)
+            if constexpr (std::is_same_v<T, float> && COLUMN_COUNT == 4 && ROW_COUNT == 4) {
+                if (!std::is_constant_evaluated()) {
+                    simd::multiply_matrix4_vector4(array.data(), rhs.data(), result.data());
+                    return result;
+                }
+            }
+#endif
+
             for (size_t row = 0; row < ROW_COUNT; ++row) {
                 for (size_t column = 0; column < COLUMN_COUNT; ++column) {
                     result[row] += (*this)[column][row] * rhs[column];
@@ -73,6 +94,14 @@ namespace math {
             return array;
         }
 
+        constexpr T* data() {
+            return array.data();
+        }
+
+        constexpr const T* data() const {
+            return array.data();
+        }
+
     protected:
         std::array<T, SIZE> array = {};
     };
@@ -82,7 +111,7 @@ namespace math {
     using Matrix4f = Matrix<float, 4, 4>;
 
     constexpr Matrix4f perspective_projection(float FOV, float aspect_ratio, float near, float far) {
-        float d = 1.0f / std::tanf(FOV * 0.5f);
+        float d = 1.0f / math::tan(FOV * 0.5f);
 
         return Matrix4f {
             d / aspect_ratio, 0.0f, 0.0f, 0.0f,
@@ -92,6 +121,19 @@ namespace math {
         };
     }
 
+    constexpr Matrix4f inverse_perspective_projection(float FOV, float aspect_ratio, float near, float far) {
+        float d = 1.0f / math::tan(FOV * 0.5f);
+        float a = (far + near) / (far - near);
+        float b = -2.0f * far * near / (far - near);
+
+        return Matrix4f {
+            aspect_ratio / d, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f / d, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f / b,
+            0.0f, 0.0f, 1.0f, -a / b
+        };
+    }
+
     constexpr Matrix4f translation(float x, float y, float z) {
         return Matrix4f {
             1.0f, 0.0f, 0.0f, 0.0f,
@@ -103,9 +145,18 @@ namespace math {
 
     constexpr Matrix4f rotation_y(float angle) {
         return Matrix4f {
-            std::cosf(angle), 0.0f, -std::sinf(angle), 0.0f,
+            math::cos(angle), 0.0f, -math::sin(angle), 0.0f,
             0.0f, 1.0f, 0.0f, 0.0f,
-            std::sinf(angle), 0.0f, std::cosf(angle), 0.0f,
+            math::sin(angle), 0.0f, math::cos(angle), 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f
+        };
+    }
+
+    constexpr Matrix4f rotation_z(float angle) {
+        return Matrix4f {
+            math::cos(angle), math::sin(angle), 0.0f, 0.0f,
+            -math::sin(angle), math::cos(angle), 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
             0.0f, 0.0f, 0.0f, 1.0f
         };
     }
@@ -113,8 +164,8 @@ namespace math {
     constexpr Matrix4f rotation_x(float angle) {
         return Matrix4f {
             1.0f, 0.0f, 0.0f, 0.0f,
-            0.0f, std::cos(angle), -std::sin(angle), 0.0f,
-            0.0f, std::sin(angle), std::cos(angle), 0.0f,
+            0.0f, math::cos(angle), -math::sin(angle), 0.0f,
+            0.0f, math::sin(angle), math::cos(angle), 0.0f,
             0.0f, 0.0f, 0.0f, 1.0f
         };
     }
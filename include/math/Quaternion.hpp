@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cmath>
+
+#include "math/Matrix.hpp"
+#include "math/Vector.hpp"
+
+namespace math {
+    template <typename T>
+    struct Quaternion {
+    public:
+        constexpr Quaternion() = default;
+        constexpr Quaternion(T x, T y, T z, T w) : components(x, y, z, w) {}
+
+        static Quaternion from_axis_angle(const Vector<T, 3>& axis, T angle) {
+            T half_sin = std::sin(angle * T(0.5));
+            return Quaternion(axis.x() * half_sin, axis.y() * half_sin, axis.z() * half_sin, std::cos(angle * T(0.5)));
+        }
+
+        constexpr Quaternion operator*(const Quaternion& rhs) const {
+            return Quaternion(
+                w() * rhs.x() + x() * rhs.w() + y() * rhs.z() - z() * rhs.y(),
+                w() * rhs.y() - x() * rhs.z() + y() * rhs.w() + z() * rhs.x(),
+                w() * rhs.z() + x() * rhs.y() - y() * rhs.x() + z() * rhs.w(),
+                w() * rhs.w() - x() * rhs.x() - y() * rhs.y() - z() * rhs.z()
+            );
+        }
+
+        constexpr bool operator==(const Quaternion& rhs) const {
+            return components == rhs.components;
+        }
+
+        constexpr bool operator!=(const Quaternion& rhs) const {
+            return !(*this == rhs);
+        }
+
+        constexpr Quaternion conjugate() const {
+            return Quaternion(-x(), -y(), -z(), w());
+        }
+
+        Quaternion normalize() const {
+            Quaternion result;
+            result.components = components.normalize();
+            return result;
+        }
+
+        constexpr Vector<T, 3> rotate(const Vector<T, 3>& vector) const {
+            // v' = v + 2w(q x v) + 2q x (q x v), with q the vector part.
+            Vector<T, 3> axis(x(), y(), z());
+            Vector<T, 3> t = axis.cross(vector) * T(2);
+            return vector + t * w() + axis.cross(t);
+        }
+
+        constexpr Matrix<T, 4, 4> to_matrix() const {
+            T xx = x() * x(), yy = y() * y(), zz = z() * z();
+            T xy = x() * y(), xz = x() * z(), yz = y() * z();
+            T wx = w() * x(), wy = w() * y(), wz = w() * z();
+
+            return Matrix<T, 4, 4> {
+                T(1) - T(2) * (yy + zz), T(2) * (xy + wz), T(2) * (xz - wy), T(0),
+                T(2) * (xy - wz), T(1) - T(2) * (xx + zz), T(2) * (yz + wx), T(0),
+                T(2) * (xz + wy), T(2) * (yz - wx), T(1) - T(2) * (xx + yy), T(0),
+                T(0), T(0), T(0), T(1)
+            };
+        }
+
+        constexpr const T& x() const { return components.x(); }
+        constexpr const T& y() const { return components.y(); }
+        constexpr const T& z() const { return components.z(); }
+        constexpr const T& w() const { return components.w(); }
+
+    private:
+        Vector<T, 4> components = Vector<T, 4>(T(0), T(0), T(0), T(1));
+    };
+
+    using Quaternionf = Quaternion<float>;
+}
\ No newline at end of file
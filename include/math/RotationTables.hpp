@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "math/Matrix.hpp"
+#include "math/Trig.hpp"
+#include "math/pi.hpp"
+
+namespace math {
+    template <size_t STEPS>
+    constexpr std::array<Matrix4f, STEPS> make_rotation_y_steps() {
+        std::array<Matrix4f, STEPS> table;
+        for (size_t i = 0; i < STEPS; ++i) {
+            table[i] = rotation_y(2.0f * pi<float>() * (float)i / (float)STEPS);
+        }
+
+        return table;
+    }
+
+    namespace detail {
+        // Quarter turns land on exact integers, so the few ulps the series leaves behind are snapped away.
+        constexpr Matrix4f snap_to_integers(const Matrix4f& matrix) {
+            Matrix4f result;
+            for (size_t i = 0; i < Matrix4f::SIZE; ++i) {
+                float value = matrix.data()[i];
+                result.data()[i] = value > 0.5f ? 1.0f : (value < -0.5f ? -1.0f : 0.0f);
+            }
+
+            return result;
+        }
+
+        constexpr std::array<Matrix4f, 24> make_block_orientations() {
+            constexpr float quarter = pi<float>() * 0.5f;
+
+            // Turns +z onto each of the six faces: south, north, east, west, up, down.
+            std::array<Matrix4f, 6> facings = {
+                rotation_y(0.0f),
+                rotation_y(2.0f * quarter),
+                rotation_y(quarter),
+                rotation_y(-quarter),
+                rotation_x(quarter),
+                rotation_x(-quarter)
+            };
+
+            std::array<Matrix4f, 24> table;
+            for (size_t facing = 0; facing < facings.size(); ++facing) {
+                for (size_t spin = 0; spin < 4; ++spin) {
+                    table[facing * 4 + spin] = snap_to_integers(facings[facing] * rotation_z(quarter * (float)spin));
+                }
+            }
+
+            return table;
+        }
+    }
+
+    // Every axis-aligned orientation of a block: index = facing * 4 + quarter turns around the facing.
+    inline constexpr std::array<Matrix4f, 24> BLOCK_ORIENTATIONS = detail::make_block_orientations();
+
+    // 16 steps matches the placement granularity of signs, banners and skulls.
+    inline constexpr std::array<Matrix4f, 16> ROTATION_Y_STEPS = make_rotation_y_steps<16>();
+
+    inline constexpr std::array<float, 256> SIN_TABLE = make_sin_table<256>();
+}
\ No newline at end of file
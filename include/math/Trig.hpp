@@ -0,0 +1,207 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "math/simd.hpp"
+#include "math/pi.hpp"
+
+namespace math {
+    namespace detail {
+        // Compile-time evaluation reduces to [-pi/4, pi/4] around the nearest multiple of pi/2 and sums
+        // the Taylor series in double, well past float precision for the angles we build tables from.
+        constexpr double reduce_quarter_turn(double angle, int64_t& quadrant) {
+            constexpr double inverse_half_pi = 2.0 / pi<double>();
+            double turns = angle * inverse_half_pi;
+            int64_t nearest = static_cast<int64_t>(turns + (turns >= 0.0 ? 0.5 : -0.5));
+            quadrant = nearest & 3;
+
+            // pi/2 split in two so the product with a large quadrant count stays exact.
+            constexpr double half_pi_high = 1.5707963267341256;
+            constexpr double half_pi_low = 6.077100506506192e-11;
+            return (angle - (double)nearest * half_pi_high) - (double)nearest * half_pi_low;
+        }
+
+        constexpr double sin_series(double x) {
+            double x2 = x * x;
+            double term = x;
+            double sum = x;
+            for (int i = 1; i < 12; ++i) {
+                term *= -x2 / (double)((2 * i) * (2 * i + 1));
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        constexpr double cos_series(double x) {
+            double x2 = x * x;
+            double term = 1.0;
+            double sum = 1.0;
+            for (int i = 1; i < 12; ++i) {
+                term *= -x2 / (double)((2 * i - 1) * (2 * i));
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        constexpr double constexpr_sin(double angle) {
+            int64_t quadrant = 0;
+            double x = reduce_quarter_turn(angle, quadrant);
+            switch (quadrant) {
+                case 0: return sin_series(x);
+                case 1: return cos_series(x);
+                case 2: return -sin_series(x);
+                default: return -cos_series(x);
+            }
+        }
+
+        constexpr double constexpr_cos(double angle) {
+            int64_t quadrant = 0;
+            double x = reduce_quarter_turn(angle, quadrant);
+            switch (quadrant) {
+                case 0: return cos_series(x);
+                case 1: return -sin_series(x);
+                case 2: return -cos_series(x);
+                default: return sin_series(x);
+            }
+        }
+    }
+
+    // Usable in constant expressions; at run time these forward to the C library.
+    template <typename T>
+    requires std::is_floating_point_v<T>
+    constexpr T sin(T angle) {
+        if (std::is_constant_evaluated()) {
+            return static_cast<T>(detail::constexpr_sin(static_cast<double>(angle)));
+        }
+
+        return std::sin(angle);
+    }
+
+    template <typename T>
+    requires std::is_floating_point_v<T>
+    constexpr T cos(T angle) {
+        if (std::is_constant_evaluated()) {
+            return static_cast<T>(detail::constexpr_cos(static_cast<double>(angle)));
+        }
+
+        return std::cos(angle);
+    }
+
+    template <typename T>
+    requires std::is_floating_point_v<T>
+    constexpr T tan(T angle) {
+        if (std::is_constant_evaluated()) {
+            return static_cast<T>(detail::constexpr_sin(static_cast<double>(angle)) / detail::constexpr_cos(static_cast<double>(angle)));
+        }
+
+        return std::tan(angle);
+    }
+
+    template <size_t COUNT>
+    constexpr std::array<float, COUNT> make_sin_table() {
+        std::array<float, COUNT> table = {};
+        for (size_t i = 0; i < COUNT; ++i) {
+            table[i] = static_cast<float>(detail::constexpr_sin(2.0 * pi<double>() * (double)i / (double)COUNT));
+        }
+
+        return table;
+    }
+
+    namespace detail {
+        // Cephes-style single precision sincos: Cody-Waite reduction by pi/2 and minimax polynomials
+        // on [-pi/4, pi/4]. Absolute error stays below 2e-7 for |angle| < 8192.
+        inline constexpr float fast_half_pi_1 = 1.5703125f;
+        inline constexpr float fast_half_pi_2 = 4.837512969970703125e-4f;
+        inline constexpr float fast_half_pi_3 = 7.54978995489188216e-8f;
+        inline constexpr float fast_sin_c0 = -1.6666654611e-1f;
+        inline constexpr float fast_sin_c1 = 8.3321608736e-3f;
+        inline constexpr float fast_sin_c2 = -1.9515295891e-4f;
+        inline constexpr float fast_cos_c0 = 4.166664568298827e-2f;
+        inline constexpr float fast_cos_c1 = -1.388731625493765e-3f;
+        inline constexpr float fast_cos_c2 = 2.443315711809948e-5f;
+
+        // Adding and removing 1.5 * 2^23 rounds to the nearest integer without a conversion.
+        inline constexpr float round_magic = 12582912.0f;
+    }
+
+    inline void fast_sincos(float angle, float& sine, float& cosine) {
+        float turns = angle * (2.0f / pi<float>());
+        float quadrant_count = (turns + detail::round_magic) - detail::round_magic;
+
+        float x = angle - quadrant_count * detail::fast_half_pi_1;
+        x -= quadrant_count * detail::fast_half_pi_2;
+        x -= quadrant_count * detail::fast_half_pi_3;
+
+        float x2 = x * x;
+        float s = x + x * x2 * (detail::fast_sin_c0 + x2 * (detail::fast_sin_c1 + x2 * detail::fast_sin_c2));
+        float c = 1.0f - 0.5f * x2 + x2 * x2 * (detail::fast_cos_c0 + x2 * (detail::fast_cos_c1 + x2 * detail::fast_cos_c2));
+
+        int quadrant = static_cast<int>(quadrant_count) & 3;
+        float swapped_sine = (quadrant & 1) ? c : s;
+        float swapped_cosine = (quadrant & 1) ? s : c;
+        sine = (quadrant & 2) ? -swapped_sine : swapped_sine;
+        cosine = (quadrant == 1 || quadrant == 2) ? -swapped_cosine : swapped_cosine;
+    }
+
+    inline void fast_sincos(std::span<const float> angles, std::span<float> sines, std::span<float> cosines) {
+        size_t count = angles.size();
+        assert(sines.size() >= count && cosines.size() >= count);
+
+        size_t i = 0;
+
+#if defined(MATH_SIMD_SSE)
+        simd::WideFloat magic = simd::splat(detail::round_magic);
+        simd::WideFloat two_over_pi = simd::splat(2.0f / pi<float>());
+        simd::WideFloat one = simd::splat(1.0f);
+        simd::WideFloat two = simd::splat(2.0f);
+        simd::WideFloat three = simd::splat(3.0f);
+        simd::WideFloat sign = simd::splat(-0.0f);
+
+        for (; i + simd::WIDTH <= count; i += simd::WIDTH) {
+            simd::WideFloat angle = simd::load_wide(angles.data() + i);
+            simd::WideFloat quadrant_count = simd::sub(simd::add(simd::mul(angle, two_over_pi), magic), magic);
+
+            simd::WideFloat x = simd::sub(angle, simd::mul(quadrant_count, simd::splat(detail::fast_half_pi_1)));
+            x = simd::sub(x, simd::mul(quadrant_count, simd::splat(detail::fast_half_pi_2)));
+            x = simd::sub(x, simd::mul(quadrant_count, simd::splat(detail::fast_half_pi_3)));
+
+            simd::WideFloat x2 = simd::mul(x, x);
+            simd::WideFloat s = simd::multiply_add(simd::splat(detail::fast_sin_c2), x2, simd::splat(detail::fast_sin_c1));
+            s = simd::multiply_add(s, x2, simd::splat(detail::fast_sin_c0));
+            s = simd::multiply_add(simd::mul(s, x2), x, x);
+            simd::WideFloat c = simd::multiply_add(simd::splat(detail::fast_cos_c2), x2, simd::splat(detail::fast_cos_c1));
+            c = simd::multiply_add(c, x2, simd::splat(detail::fast_cos_c0));
+            c = simd::multiply_add(simd::mul(c, x2), x2, simd::sub(one, simd::mul(simd::splat(0.5f), x2)));
+
+            // quadrant = quadrant_count mod 4, still as float: subtracting 0.375 before rounding
+            // quadrant_count / 4 turns round-to-nearest into floor for integer inputs.
+            simd::WideFloat fours = simd::sub(simd::add(simd::mul(simd::sub(quadrant_count, simd::splat(1.5f)), simd::splat(0.25f)), magic), magic);
+            simd::WideFloat quadrant = simd::sub(quadrant_count, simd::mul(fours, simd::splat(4.0f)));
+
+            simd::WideFloat odd = simd::bit_or(simd::equal(quadrant, one), simd::equal(quadrant, three));
+            simd::WideFloat sine = simd::select(odd, c, s);
+            simd::WideFloat cosine = simd::select(odd, s, c);
+
+            simd::WideFloat negate_sine = simd::bit_and(simd::less_than(one, quadrant), sign);
+            simd::WideFloat negate_cosine = simd::bit_and(
+                simd::bit_or(simd::equal(quadrant, one), simd::equal(quadrant, two)), sign
+            );
+
+            simd::store_wide(sines.data() + i, simd::bit_xor(sine, negate_sine));
+            simd::store_wide(cosines.data() + i, simd::bit_xor(cosine, negate_cosine));
+        }
+#endif
+
+        for (; i < count; ++i) {
+            fast_sincos(angles[i], sines[i], cosines[i]);
+        }
+    }
+}
\ No newline at end of file
@@ -2,6 +2,12 @@
 
 #include <array>
 #include <cmath>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "math/simd.hpp"
 
 namespace math {
     template <typename T, size_t SIZE>
@@ -63,7 +69,7 @@ namespace math {
         constexpr Vector operator-() const {
             Vector<T, SIZE> result = *this;
             for (size_t i = 0; i < SIZE; ++i) {
-                result = -result;
+                result.array[i] = -result.array[i];
             }
 
             return result;
@@ -115,21 +121,50 @@ namespace math {
             return true;
         }
 
-        constexpr T length_squared() const {
+        constexpr T dot(const Vector<T, SIZE>& rhs) const {
+#if defined(MATH_SIMD_SSE)
+            if constexpr (std::is_same_v<T, float> && SIZE == 4) {
+                if (!std::is_constant_evaluated()) {
+                    return simd::dot4(array.data(), rhs.array.data());
+                }
+            }
+#endif
+
             T sum = {};
             for (size_t i = 0; i < SIZE; ++i) {
-                sum += array[i] * array[i];
+                sum += array[i] * rhs.array[i];
             }
 
             return sum;
         }
 
+        constexpr Vector cross(const Vector<T, SIZE>& rhs) const requires (SIZE == 3) {
+            return Vector<T, SIZE>(
+                array[1] * rhs.array[2] - array[2] * rhs.array[1],
+                array[2] * rhs.array[0] - array[0] * rhs.array[2],
+                array[0] * rhs.array[1] - array[1] * rhs.array[0]
+            );
+        }
+
+        constexpr T length_squared() const {
+            return dot(*this);
+        }
+
         constexpr T length() const {
             return std::sqrt(length_squared());
         }
 
         constexpr Vector normalize() const {
             Vector<T, SIZE> result = *this;
+#if defined(MATH_SIMD_SSE)
+            if constexpr (std::is_same_v<T, float> && SIZE == 4) {
+                if (!std::is_constant_evaluated()) {
+                    simd::normalize4(array.data(), result.array.data());
+                    return result;
+                }
+            }
+#endif
+
             T length = this->length();
             for (size_t i = 0; i < SIZE; ++i) {
                 result.array[i] /= length;
@@ -148,6 +183,14 @@ namespace math {
             return array[index];
         }
 
+        constexpr T* data() {
+            return array.data();
+        }
+
+        constexpr const T* data() const {
+            return array.data();
+        }
+
         constexpr T& x() {
             return array[0];
         }
@@ -185,7 +228,24 @@ namespace math {
         static constexpr T ZERO = {};
     };
 
+    template <typename To, typename From, size_t SIZE>
+    constexpr Vector<To, SIZE> vector_cast(const Vector<From, SIZE>& value) {
+        Vector<To, SIZE> result;
+        for (size_t i = 0; i < SIZE; ++i) {
+            result[i] = static_cast<To>(value[i]);
+        }
+
+        return result;
+    }
+
     using Vector2f = Vector<float, 2>;
     using Vector3f = Vector<float, 3>;
     using Vector4f = Vector<float, 4>;
+
+    using Vector3d = Vector<double, 3>;
+
+    using Vector2i = Vector<int32_t, 2>;
+    using Vector3i = Vector<int32_t, 3>;
+    using Vector4i = Vector<int32_t, 4>;
+    using Vector3i64 = Vector<int64_t, 3>;
 }
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+
+#if !defined(MATH_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define MATH_SIMD_SSE 1
+    #endif
+
+    #if defined(MATH_SIMD_SSE) && (defined(__SSE4_1__) || defined(__AVX__))
+        #define MATH_SIMD_SSE41 1
+    #endif
+
+    #if defined(MATH_SIMD_SSE) && defined(__AVX__)
+        #define MATH_SIMD_AVX 1
+    #endif
+
+    #if defined(MATH_SIMD_AVX) && (defined(__FMA__) || defined(__AVX2__))
+        #define MATH_SIMD_FMA 1
+    #endif
+#endif
+
+#include <cstddef>
+
+#if defined(MATH_SIMD_SSE)
+    #include <immintrin.h>
+#endif
+
+namespace math::simd {
+#if defined(MATH_SIMD_AVX)
+    inline constexpr const char* NAME = "avx";
+#elif defined(MATH_SIMD_SSE)
+    inline constexpr const char* NAME = "sse";
+#else
+    inline constexpr const char* NAME = "scalar";
+#endif
+
+#if defined(MATH_SIMD_SSE)
+    inline __m128 multiply_add(__m128 a, __m128 b, __m128 c) {
+    #if defined(MATH_SIMD_FMA)
+        return _mm_fmadd_ps(a, b, c);
+    #else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    #endif
+    }
+
+    // Returns the dot product of a and b in every lane.
+    inline __m128 dot4_splat(__m128 a, __m128 b) {
+    #if defined(MATH_SIMD_SSE41)
+        return _mm_dp_ps(a, b, 0xFF);
+    #else
+        __m128 product = _mm_mul_ps(a, b);
+        __m128 sum = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    #endif
+    }
+
+    // All matrices are 16 column-major floats, matching math::Matrix4f storage.
+    inline void multiply_matrix4(const float* lhs, const float* rhs, float* result) {
+    #if defined(MATH_SIMD_AVX)
+        __m256 lhs_0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 0));
+        __m256 lhs_1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 4));
+        __m256 lhs_2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 8));
+        __m256 lhs_3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 12));
+
+        for (int i = 0; i < 16; i += 8) {
+            __m256 columns = _mm256_loadu_ps(rhs + i);
+            __m256 sum = _mm256_mul_ps(lhs_0, _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(0, 0, 0, 0)));
+        #if defined(MATH_SIMD_FMA)
+            sum = _mm256_fmadd_ps(lhs_1, _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(1, 1, 1, 1)), sum);
+            sum = _mm256_fmadd_ps(lhs_2, _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(2, 2, 2, 2)), sum);
+            sum = _mm256_fmadd_ps(lhs_3, _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(3, 3, 3, 3)), sum);
+        #else
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(lhs_1, _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(1, 1, 1, 1))));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(lhs_2, _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(2, 2, 2, 2))));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(lhs_3, _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(3, 3, 3, 3))));
+        #endif
+            _mm256_storeu_ps(result + i, sum);
+        }
+    #else
+        __m128 lhs_0 = _mm_loadu_ps(lhs + 0);
+        __m128 lhs_1 = _mm_loadu_ps(lhs + 4);
+        __m128 lhs_2 = _mm_loadu_ps(lhs + 8);
+        __m128 lhs_3 = _mm_loadu_ps(lhs + 12);
+
+        for (int i = 0; i < 16; i += 4) {
+            __m128 sum = _mm_mul_ps(lhs_0, _mm_set1_ps(rhs[i + 0]));
+            sum = multiply_add(lhs_1, _mm_set1_ps(rhs[i + 1]), sum);
+            sum = multiply_add(lhs_2, _mm_set1_ps(rhs[i + 2]), sum);
+            sum = multiply_add(lhs_3, _mm_set1_ps(rhs[i + 3]), sum);
+            _mm_storeu_ps(result + i, sum);
+        }
+    #endif
+    }
+
+    inline void multiply_matrix4_vector4(const float* matrix, const float* vector, float* result) {
+        __m128 sum = _mm_mul_ps(_mm_loadu_ps(matrix + 0), _mm_set1_ps(vector[0]));
+        sum = multiply_add(_mm_loadu_ps(matrix + 4), _mm_set1_ps(vector[1]), sum);
+        sum = multiply_add(_mm_loadu_ps(matrix + 8), _mm_set1_ps(vector[2]), sum);
+        sum = multiply_add(_mm_loadu_ps(matrix + 12), _mm_set1_ps(vector[3]), sum);
+        _mm_storeu_ps(result, sum);
+    }
+
+    inline float dot4(const float* lhs, const float* rhs) {
+        return _mm_cvtss_f32(dot4_splat(_mm_loadu_ps(lhs), _mm_loadu_ps(rhs)));
+    }
+
+    inline void normalize4(const float* vector, float* result) {
+        __m128 value = _mm_loadu_ps(vector);
+        __m128 length = _mm_sqrt_ps(dot4_splat(value, value));
+        _mm_storeu_ps(result, _mm_div_ps(value, length));
+    }
+
+    // Widest float vector available, used by the batched SoA kernels.
+#if defined(MATH_SIMD_AVX)
+    using WideFloat = __m256;
+    inline constexpr size_t WIDTH = 8;
+
+    inline WideFloat load_wide(const float* source) { return _mm256_loadu_ps(source); }
+    inline void store_wide(float* destination, WideFloat value) { _mm256_storeu_ps(destination, value); }
+    inline WideFloat splat(float value) { return _mm256_set1_ps(value); }
+    inline WideFloat add(WideFloat a, WideFloat b) { return _mm256_add_ps(a, b); }
+    inline WideFloat sub(WideFloat a, WideFloat b) { return _mm256_sub_ps(a, b); }
+    inline WideFloat mul(WideFloat a, WideFloat b) { return _mm256_mul_ps(a, b); }
+    inline WideFloat min(WideFloat a, WideFloat b) { return _mm256_min_ps(a, b); }
+    inline WideFloat max(WideFloat a, WideFloat b) { return _mm256_max_ps(a, b); }
+    inline WideFloat abs(WideFloat a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    inline WideFloat less_than(WideFloat a, WideFloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    inline WideFloat equal(WideFloat a, WideFloat b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    inline WideFloat bit_or(WideFloat a, WideFloat b) { return _mm256_or_ps(a, b); }
+    inline WideFloat bit_and(WideFloat a, WideFloat b) { return _mm256_and_ps(a, b); }
+    inline WideFloat bit_xor(WideFloat a, WideFloat b) { return _mm256_xor_ps(a, b); }
+    inline WideFloat select(WideFloat mask, WideFloat if_true, WideFloat if_false) { return _mm256_blendv_ps(if_false, if_true, mask); }
+    inline unsigned mask_bits(WideFloat mask) { return static_cast<unsigned>(_mm256_movemask_ps(mask)); }
+
+    inline WideFloat multiply_add(WideFloat a, WideFloat b, WideFloat c) {
+    #if defined(MATH_SIMD_FMA)
+        return _mm256_fmadd_ps(a, b, c);
+    #else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+    #endif
+    }
+#else
+    using WideFloat = __m128;
+    inline constexpr size_t WIDTH = 4;
+
+    inline WideFloat load_wide(const float* source) { return _mm_loadu_ps(source); }
+    inline void store_wide(float* destination, WideFloat value) { _mm_storeu_ps(destination, value); }
+    inline WideFloat splat(float value) { return _mm_set1_ps(value); }
+    inline WideFloat add(WideFloat a, WideFloat b) { return _mm_add_ps(a, b); }
+    inline WideFloat sub(WideFloat a, WideFloat b) { return _mm_sub_ps(a, b); }
+    inline WideFloat mul(WideFloat a, WideFloat b) { return _mm_mul_ps(a, b); }
+    inline WideFloat min(WideFloat a, WideFloat b) { return _mm_min_ps(a, b); }
+    inline WideFloat max(WideFloat a, WideFloat b) { return _mm_max_ps(a, b); }
+    inline WideFloat abs(WideFloat a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    inline WideFloat less_than(WideFloat a, WideFloat b) { return _mm_cmplt_ps(a, b); }
+    inline WideFloat equal(WideFloat a, WideFloat b) { return _mm_cmpeq_ps(a, b); }
+    inline WideFloat bit_or(WideFloat a, WideFloat b) { return _mm_or_ps(a, b); }
+    inline WideFloat bit_and(WideFloat a, WideFloat b) { return _mm_and_ps(a, b); }
+    inline WideFloat bit_xor(WideFloat a, WideFloat b) { return _mm_xor_ps(a, b); }
+
+    inline WideFloat select(WideFloat mask, WideFloat if_true, WideFloat if_false) {
+    #if defined(MATH_SIMD_SSE41)
+        return _mm_blendv_ps(if_false, if_true, mask);
+    #else
+        return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+    #endif
+    }
+    inline unsigned mask_bits(WideFloat mask) { return static_cast<unsigned>(_mm_movemask_ps(mask)); }
+#endif
+#endif
+}
\ No newline at end of file
@@ -1,8 +1,22 @@
 #version 330 core
 
+layout (std140) uniform FrameData {
+    mat4 u_view_projection;
+    vec4 u_camera_position;
+    vec4 u_fog_color;
+    vec4 u_fog_time;
+};
+
+// One layer per TextureLayer; see include/BlockTextures.hpp.
+uniform sampler2DArray u_block_textures;
+
 in vec4 vertexColor;
+in vec3 texCoord;
+in float fogDistance;
 out vec4 FragColor;
 
 void main() {
-    FragColor = vertexColor;
+    vec4 color = texture(u_block_textures, texCoord) * vertexColor;
+    float fog = clamp((fogDistance - u_fog_time.x) / (u_fog_time.y - u_fog_time.x), 0.0, 1.0);
+    FragColor = vec4(mix(color.rgb, u_fog_color.rgb, fog), color.a);
 }
\ No newline at end of file
@@ -1,13 +1,48 @@
 #version 330 core
 
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec4 aCol;
+// See include/Vertex.hpp for the packing.
+layout (location = 0) in uvec2 aData;
 
-uniform mat4 u_projection;
+// See include/FrameData.hpp.
+layout (std140) uniform FrameData {
+    mat4 u_view_projection;
+    vec4 u_camera_position;
+    vec4 u_fog_color;
+    vec4 u_fog_time;
+};
+
+// Camera-relative origin of each section, indexed by the slot in the vertex.
+uniform samplerBuffer u_section_offsets;
 
 out vec4 vertexColor;
+out vec3 texCoord;
+out float fogDistance;
+
+// Fixed light per face, in Face order (east, west, up, down, south, north).
+const float FACE_SHADES[6] = float[](0.7, 0.7, 1.0, 0.5, 0.85, 0.85);
+const float AO_LEVELS[4] = float[](0.5, 0.7, 0.85, 1.0);
 
 void main() {
-    gl_Position = u_projection * vec4(aPos, 1.0f);
-    vertexColor = aCol;
+    vec3 position = vec3(aData.x & 63u, (aData.x >> 6) & 63u, (aData.x >> 12) & 63u);
+    uint face = (aData.x >> 18) & 7u;
+    uint ao = (aData.x >> 21) & 3u;
+    uint light = (aData.x >> 23) & 15u;
+    uint lod = (aData.x >> 27) & 3u;
+    uint layer = aData.y & 0xFFFFu;
+    uint slot = aData.y >> 16;
+    vec3 section_offset = texelFetch(u_section_offsets, int(slot)).xyz;
+
+    float shade = FACE_SHADES[face] * AO_LEVELS[ao] * (float(light) / 15.0);
+
+    vec3 local_position = position * float(1u << lod);
+    // Positions are camera-relative, so the distance to the camera is just their length.
+    vec3 render_position = local_position + section_offset;
+    gl_Position = u_view_projection * vec4(render_position, 1.0f);
+    vertexColor = vec4(vec3(shade), 1.0f);
+
+    // Textures repeat once per block across merged quads, with v pointing up on side faces.
+    uint axis = face / 2u;
+    vec2 uv = axis == 0u ? local_position.zy : (axis == 1u ? local_position.xz : local_position.xy);
+    texCoord = vec3(uv, float(layer));
+    fogDistance = length(render_position);
 }
\ No newline at end of file
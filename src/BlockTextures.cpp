@@ -0,0 +1,136 @@
+#include "BlockTextures.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+// From GL_EXT_texture_filter_anisotropic, core only since 4.6; glad is generated for plain 3.3.
+#ifndef GL_TEXTURE_MAX_ANISOTROPY_EXT
+    #define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
+#endif
+
+#ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
+    #define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
+#endif
+
+static_assert((1 << (BlockTextures::LEVEL_COUNT - 1)) == BlockTextures::TEXTURE_SIZE);
+
+using Color = std::array<float, 3>;
+
+// Base colours per texture layer, in TextureLayer order.
+static constexpr std::array<Color, (size_t)TextureLayer::COUNT> LAYER_COLORS = {{
+    {0.5f, 0.5f, 0.5f},
+    {0.45f, 0.3f, 0.2f},
+    {0.3f, 0.65f, 0.2f},
+    {0.45f, 0.3f, 0.2f},
+    {0.85f, 0.8f, 0.55f},
+    {0.35f, 0.25f, 0.15f},
+    {0.6f, 0.5f, 0.3f},
+    {0.2f, 0.45f, 0.15f}
+}};
+
+// Repeatable per-texel noise in [0, 1).
+static float texel_noise(TextureLayer layer, int x, int y) {
+    uint32_t hash = (uint32_t)layer * 0x9E3779B9u ^ (uint32_t)x * 0x85EBCA6Bu ^ (uint32_t)y * 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    hash *= 0x7FEB352Du;
+    hash ^= hash >> 15;
+    hash *= 0x846CA68Bu;
+    hash ^= hash >> 16;
+    return (float)(hash >> 8) / (float)(1u << 24);
+}
+
+static Color scale(const Color& color, float brightness) {
+    return {color[0] * brightness, color[1] * brightness, color[2] * brightness};
+}
+
+// Row 0 is the bottom of the texture, which the vertex shader maps to the bottom of side faces.
+static Color texel_color(TextureLayer layer, int x, int y) {
+    constexpr int size = BlockTextures::TEXTURE_SIZE;
+    const Color& base = LAYER_COLORS[(size_t)layer];
+    float noise = texel_noise(layer, x, y);
+
+    switch (layer) {
+        case TextureLayer::GrassSide: {
+            // A fringe of grass hanging over the dirt, one or two texels deeper in places.
+            int fringe = 3 + (int)(texel_noise(layer, x, -1) * 2.0f);
+            if (y >= size - fringe) {
+                return scale(LAYER_COLORS[(size_t)TextureLayer::GrassTop], 0.85f + 0.3f * noise);
+            }
+
+            return scale(base, 0.8f + 0.4f * noise);
+        }
+        case TextureLayer::LogSide:
+            // Vertical bark grooves.
+            return scale(base, (x % 4 == 0 ? 0.7f : 1.0f) * (0.9f + 0.2f * noise));
+        case TextureLayer::LogTop: {
+            float dx = (float)x + 0.5f - (float)size / 2.0f;
+            float dy = (float)y + 0.5f - (float)size / 2.0f;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            if (distance > (float)size / 2.0f - 1.5f) {
+                return scale(LAYER_COLORS[(size_t)TextureLayer::LogSide], 0.9f + 0.2f * noise);
+            }
+
+            return scale(base, ((int)distance % 3 == 0 ? 0.8f : 1.0f) * (0.95f + 0.1f * noise));
+        }
+        case TextureLayer::Leaves:
+            return scale(base, noise < 0.25f ? 0.6f : 0.9f + 0.3f * noise);
+        case TextureLayer::Sand:
+            return scale(base, 0.92f + 0.16f * noise);
+        default:
+            return scale(base, 0.8f + 0.4f * noise);
+    }
+}
+
+BlockTextures::BlockTextures(GLState& gl_state) : gl_state(gl_state) {
+    constexpr size_t layer_count = (size_t)TextureLayer::COUNT;
+
+    std::vector<GLubyte> pixels;
+    pixels.reserve(layer_count * TEXTURE_SIZE * TEXTURE_SIZE * 4);
+    for (size_t layer = 0; layer < layer_count; ++layer) {
+        for (int y = 0; y < TEXTURE_SIZE; ++y) {
+            for (int x = 0; x < TEXTURE_SIZE; ++x) {
+                Color color = texel_color((TextureLayer)layer, x, y);
+                for (float channel : color) {
+                    pixels.push_back((GLubyte)std::lround(std::clamp(channel, 0.0f, 1.0f) * 255.0f));
+                }
+
+                pixels.push_back(255);
+            }
+        }
+    }
+
+    glGenTextures(1, &texture);
+    gl_state.bind_texture(0, GL_TEXTURE_2D_ARRAY, texture);
+    glTexImage3D(
+        GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, TEXTURE_SIZE, TEXTURE_SIZE, (GLsizei)layer_count, 0,
+        GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()
+    );
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+    // Nearest magnification keeps texels crisp up close; trilinear minification, which anisotropic
+    // filtering builds on, keeps distant tiling from shimmering.
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, LEVEL_COUNT - 1);
+
+    if (glfwExtensionSupported("GL_EXT_texture_filter_anisotropic") || glfwExtensionSupported("GL_ARB_texture_filter_anisotropic")) {
+        GLfloat max_anisotropy = 1.0f;
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &max_anisotropy);
+        anisotropy = std::min(max_anisotropy, MAX_ANISOTROPY);
+        glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisotropy);
+    }
+}
+
+BlockTextures::~BlockTextures() noexcept {
+    gl_state.forget_texture(texture);
+    glDeleteTextures(1, &texture);
+}
+
+void BlockTextures::bind(GLuint unit) {
+    gl_state.bind_texture(unit, GL_TEXTURE_2D_ARRAY, texture);
+}
\ No newline at end of file
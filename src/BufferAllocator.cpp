@@ -0,0 +1,68 @@
+#include "BufferAllocator.hpp"
+
+#include <cassert>
+#include <iterator>
+
+BufferAllocator::BufferAllocator(size_t capacity) : capacity(capacity), free_size(capacity) {
+    if (capacity != 0) {
+        free_blocks.emplace(0, capacity);
+    }
+}
+
+size_t BufferAllocator::allocate(size_t size) {
+    assert(size != 0);
+
+    for (auto it = free_blocks.begin(); it != free_blocks.end(); ++it) {
+        if (it->second < size) {
+            continue;
+        }
+
+        size_t offset = it->first;
+        size_t remaining = it->second - size;
+        free_blocks.erase(it);
+        if (remaining != 0) {
+            free_blocks.emplace(offset + size, remaining);
+        }
+
+        free_size -= size;
+        return offset;
+    }
+
+    return INVALID_OFFSET;
+}
+
+void BufferAllocator::free(size_t offset, size_t size) {
+    assert(size != 0 && offset + size <= capacity);
+    free_size += size;
+
+    auto next = free_blocks.lower_bound(offset);
+    assert(next == free_blocks.end() || next->first >= offset + size);
+
+    if (next != free_blocks.begin()) {
+        auto previous = std::prev(next);
+        assert(previous->first + previous->second <= offset);
+        if (previous->first + previous->second == offset) {
+            offset = previous->first;
+            size += previous->second;
+            free_blocks.erase(previous);
+        }
+    }
+
+    if (next != free_blocks.end() && next->first == offset + size) {
+        size += next->second;
+        free_blocks.erase(next);
+    }
+
+    free_blocks.emplace(offset, size);
+}
+
+void BufferAllocator::reset(size_t new_capacity, size_t used) {
+    assert(used <= new_capacity);
+
+    capacity = new_capacity;
+    free_blocks.clear();
+    free_size = capacity - used;
+    if (free_size != 0) {
+        free_blocks.emplace(used, free_size);
+    }
+}
\ No newline at end of file
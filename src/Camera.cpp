@@ -0,0 +1,110 @@
+#include "Camera.hpp"
+
+#include <limits>
+
+void Camera::set_position(const math::Vector3d& new_position) {
+    position = new_position;
+}
+
+void Camera::set_rotation(float new_yaw, float new_pitch) {
+    if (new_yaw == yaw && new_pitch == pitch) {
+        return;
+    }
+
+    // Positive pitch looks up, and +z is forward, so the x rotation is applied with the opposite sign.
+    set_orientation(
+        math::Quaternionf::from_axis_angle(math::Vector3f(0.0f, 1.0f, 0.0f), new_yaw)
+        * math::Quaternionf::from_axis_angle(math::Vector3f(1.0f, 0.0f, 0.0f), -new_pitch)
+    );
+
+    yaw = new_yaw;
+    pitch = new_pitch;
+}
+
+void Camera::set_orientation(const math::Quaternionf& new_orientation) {
+    if (new_orientation == orientation) {
+        return;
+    }
+
+    orientation = new_orientation;
+    yaw = std::numeric_limits<float>::quiet_NaN();
+    pitch = std::numeric_limits<float>::quiet_NaN();
+    dirty |= View | ViewProjection | InverseViewProjection | Frustum;
+}
+
+void Camera::set_perspective(float new_FOV, float new_aspect_ratio, float new_near, float new_far) {
+    if (new_FOV == FOV && new_aspect_ratio == aspect_ratio && new_near == near && new_far == far) {
+        return;
+    }
+
+    FOV = new_FOV;
+    aspect_ratio = new_aspect_ratio;
+    near = new_near;
+    far = new_far;
+    dirty |= Projection | ViewProjection | InverseViewProjection | Frustum;
+}
+
+math::Vector3f Camera::get_forward() const {
+    return orientation.rotate(math::Vector3f(0.0f, 0.0f, 1.0f));
+}
+
+math::Vector3f Camera::get_right() const {
+    return orientation.rotate(math::Vector3f(1.0f, 0.0f, 0.0f));
+}
+
+math::Vector3f Camera::to_render_space(const math::Vector3d& world_position) const {
+    return math::vector_cast<float>(world_position - position);
+}
+
+const math::Affine3f& Camera::get_view_transform() const {
+    if (dirty & View) {
+        view_transform = math::Affine3f::from_rotation(orientation.conjugate());
+        view = math::Matrix4f(view_transform);
+        dirty &= ~View;
+    }
+
+    return view_transform;
+}
+
+const math::Matrix4f& Camera::get_view() const {
+    get_view_transform();
+    return view;
+}
+
+const math::Matrix4f& Camera::get_projection() const {
+    if (dirty & Projection) {
+        projection = math::perspective_projection(FOV, aspect_ratio, near, far);
+        inverse_projection = math::inverse_perspective_projection(FOV, aspect_ratio, near, far);
+        dirty &= ~Projection;
+    }
+
+    return projection;
+}
+
+const math::Matrix4f& Camera::get_view_projection() const {
+    if (dirty & ViewProjection) {
+        view_projection = get_projection() * get_view();
+        dirty &= ~ViewProjection;
+    }
+
+    return view_projection;
+}
+
+const math::Matrix4f& Camera::get_inverse_view_projection() const {
+    if (dirty & InverseViewProjection) {
+        get_projection();
+        inverse_view_projection = math::Matrix4f(get_view_transform().inverse_rigid()) * inverse_projection;
+        dirty &= ~InverseViewProjection;
+    }
+
+    return inverse_view_projection;
+}
+
+const math::Frustum& Camera::get_frustum() const {
+    if (dirty & Frustum) {
+        frustum = math::Frustum::from_matrix(get_view_projection());
+        dirty &= ~Frustum;
+    }
+
+    return frustum;
+}
\ No newline at end of file
@@ -0,0 +1,601 @@
+#include "ChunkMesher.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "math/simd.hpp"
+
+// Corners of each face of the unit cube, wound counter-clockwise when looking at the face from
+// outside, indexed by Face.
+static constexpr std::array<std::array<std::array<int, 3>, 4>, FACE_COUNT> FACE_CORNERS = {{
+    {{{1, 0, 0}, {1, 1, 0}, {1, 1, 1}, {1, 0, 1}}},
+    {{{0, 0, 0}, {0, 0, 1}, {0, 1, 1}, {0, 1, 0}}},
+    {{{0, 1, 0}, {0, 1, 1}, {1, 1, 1}, {1, 1, 0}}},
+    {{{0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 1}}},
+    {{{0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}}},
+    {{{0, 0, 0}, {0, 1, 0}, {1, 1, 0}, {1, 0, 0}}}
+}};
+
+const char* ChunkMesher::get_mode_name(Mode mode) {
+    switch (mode) {
+        case Mode::Naive: return "naive";
+        case Mode::Greedy: return "greedy";
+        case Mode::Binary: return "binary";
+        default: return "unknown";
+    }
+}
+
+void ChunkMesher::gather(const World& world, const math::Vector3i64& section, PaddedSection& padded) {
+    padded.blocks.fill(Block::Air);
+
+    constexpr int size = ChunkSection::SIZE;
+
+    if (const ChunkSection* center = world.get_section(section)) {
+        for (int y = 0; y < size; ++y) {
+            for (int z = 0; z < size; ++z) {
+                for (int x = 0; x < size; ++x) {
+                    padded.blocks[PaddedSection::index(x, y, z)] = center->get(x, y, z);
+                }
+            }
+        }
+    }
+
+    // Only the layer touching this section is copied from each neighbour; edges and corners stay
+    // air since face culling never looks diagonally.
+    for (size_t face = 0; face < FACE_COUNT; ++face) {
+        const std::array<int, 3>& direction = FACE_DIRECTIONS[face];
+        const ChunkSection* neighbour = world.get_section(section + math::Vector3i64(
+            (int64_t)direction[0], (int64_t)direction[1], (int64_t)direction[2]
+        ));
+
+        if (!neighbour) {
+            continue;
+        }
+
+        for (int a = 0; a < size; ++a) {
+            for (int b = 0; b < size; ++b) {
+                int x = direction[0] == 0 ? a : (direction[0] > 0 ? size : -1);
+                int y = direction[1] == 0 ? (direction[0] == 0 ? b : a) : (direction[1] > 0 ? size : -1);
+                int z = direction[2] == 0 ? b : (direction[2] > 0 ? size : -1);
+
+                padded.blocks[PaddedSection::index(x, y, z)] = neighbour->get(x & (size - 1), y & (size - 1), z & (size - 1));
+            }
+        }
+    }
+}
+
+// Emits one face spanning size blocks; the size along the face's own axis must be 1.
+static void emit_quad(ChunkMeshData& mesh, const std::array<int, 3>& position, const std::array<int, 3>& size, Face face, Block block) {
+    uint32_t layer = (uint32_t)texture_layer(block, face);
+
+    size_t base = mesh.vertices.size();
+    mesh.vertices.resize(base + 4);
+    Vertex* vertices = mesh.vertices.data() + base;
+    for (size_t i = 0; i < 4; ++i) {
+        const std::array<int, 3>& corner = FACE_CORNERS[(size_t)face][i];
+        vertices[i] = Vertex::pack(
+            (uint32_t)(position[0] + corner[0] * size[0]),
+            (uint32_t)(position[1] + corner[1] * size[1]),
+            (uint32_t)(position[2] + corner[2] * size[2]),
+            (uint32_t)face,
+            Vertex::MAX_AO,
+            Vertex::MAX_LIGHT,
+            layer
+        );
+    }
+}
+
+static void mesh_naive(const PaddedSection& padded, ChunkMeshData& mesh) {
+    constexpr int size = ChunkSection::SIZE;
+
+    for (int y = 0; y < size; ++y) {
+        for (int z = 0; z < size; ++z) {
+            for (int x = 0; x < size; ++x) {
+                Block block = padded.get(x, y, z);
+                if (block == Block::Air) {
+                    continue;
+                }
+
+                for (size_t face = 0; face < FACE_COUNT; ++face) {
+                    const std::array<int, 3>& direction = FACE_DIRECTIONS[face];
+                    Block neighbour = padded.get(x + direction[0], y + direction[1], z + direction[2]);
+                    if (is_face_visible(block, neighbour)) {
+                        emit_quad(mesh, {x, y, z}, {1, 1, 1}, (Face)face, block);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Per face direction and slice, collects the visible faces into a 2D mask and covers it with
+// maximal rectangles: grow along u while the block matches, then along v while the whole row does.
+// Faces only merge with the same block, which is all that decides their appearance.
+static void mesh_greedy(const PaddedSection& padded, ChunkMeshData& mesh) {
+    constexpr int size = ChunkSection::SIZE;
+    std::array<Block, (size_t)size * size> mask;
+
+    for (size_t face = 0; face < FACE_COUNT; ++face) {
+        const std::array<int, 3>& direction = FACE_DIRECTIONS[face];
+        int axis = direction[0] != 0 ? 0 : (direction[1] != 0 ? 1 : 2);
+        int u = (axis + 1) % 3;
+        int v = (axis + 2) % 3;
+
+        for (int slice = 0; slice < size; ++slice) {
+            std::array<int, 3> position;
+            position[axis] = slice;
+
+            for (int j = 0; j < size; ++j) {
+                position[v] = j;
+                for (int i = 0; i < size; ++i) {
+                    position[u] = i;
+                    Block block = padded.get(position[0], position[1], position[2]);
+                    Block neighbour = padded.get(position[0] + direction[0], position[1] + direction[1], position[2] + direction[2]);
+                    mask[(size_t)j * size + i] = is_face_visible(block, neighbour) ? block : Block::Air;
+                }
+            }
+
+            for (int j = 0; j < size; ++j) {
+                for (int i = 0; i < size; ) {
+                    Block block = mask[(size_t)j * size + i];
+                    if (block == Block::Air) {
+                        ++i;
+                        continue;
+                    }
+
+                    int width = 1;
+                    while (i + width < size && mask[(size_t)j * size + i + width] == block) {
+                        ++width;
+                    }
+
+                    int height = 1;
+                    for (; j + height < size; ++height) {
+                        const Block* row = &mask[(size_t)(j + height) * size + i];
+                        bool matches = true;
+                        for (int k = 0; k < width; ++k) {
+                            if (row[k] != block) {
+                                matches = false;
+                                break;
+                            }
+                        }
+
+                        if (!matches) {
+                            break;
+                        }
+                    }
+
+                    for (int row = 0; row < height; ++row) {
+                        std::fill_n(&mask[(size_t)(j + row) * size + i], width, Block::Air);
+                    }
+
+                    position[u] = i;
+                    position[v] = j;
+                    std::array<int, 3> extent = {1, 1, 1};
+                    extent[u] = width;
+                    extent[v] = height;
+                    emit_quad(mesh, position, extent, (Face)face, block);
+
+                    i += width;
+                }
+            }
+        }
+    }
+}
+
+// Splits a row of 32 blocks along x into opaque and see-through (non-air, non-opaque) bits.
+static void classify_row(const Block* row, uint32_t& opaque_bits, uint32_t& see_through_bits) {
+#if defined(MATH_SIMD_SSE)
+    uint32_t air = 0;
+    uint32_t not_opaque = 0;
+    for (int half = 0; half < 2; ++half) {
+        __m128i blocks = _mm_loadu_si128((const __m128i*)(row + half * 16));
+        __m128i matches = _mm_setzero_si128();
+
+        // Expanded over every block type at compile time, leaving one compare per see-through type.
+        [&]<size_t... BLOCKS>(std::index_sequence<BLOCKS...>) {
+            ((matches = is_opaque((Block)BLOCKS) ? matches : _mm_or_si128(matches, _mm_cmpeq_epi8(blocks, _mm_set1_epi8((char)BLOCKS)))), ...);
+        }(std::make_index_sequence<(size_t)Block::COUNT>());
+
+        air |= (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(blocks, _mm_set1_epi8((char)Block::Air))) << (half * 16);
+        not_opaque |= (uint32_t)_mm_movemask_epi8(matches) << (half * 16);
+    }
+
+    opaque_bits = ~not_opaque;
+    see_through_bits = not_opaque & ~air;
+#else
+    opaque_bits = 0;
+    see_through_bits = 0;
+    for (int x = 0; x < ChunkSection::SIZE; ++x) {
+        opaque_bits |= (uint32_t)is_opaque(row[x]) << x;
+        see_through_bits |= (uint32_t)(row[x] != Block::Air && !is_opaque(row[x])) << x;
+    }
+#endif
+}
+
+// Row masks along x of a whole section, indexed [y][z]. Meshing, the occlusion layers and the
+// connectivity fill all start from these, so they are classified once per section.
+struct RowMasks {
+    std::array<std::array<uint32_t, ChunkSection::SIZE>, ChunkSection::SIZE> opaque;
+    std::array<std::array<uint32_t, ChunkSection::SIZE>, ChunkSection::SIZE> see_through;
+};
+
+static void classify_rows(const PaddedSection& padded, RowMasks& masks) {
+    for (int y = 0; y < ChunkSection::SIZE; ++y) {
+        for (int z = 0; z < ChunkSection::SIZE; ++z) {
+            classify_row(&padded.blocks[PaddedSection::index(0, y, z)], masks.opaque[y][z], masks.see_through[y][z]);
+        }
+    }
+}
+
+// Transposes a 32x32 bit matrix in place, bit c of rows[r] being element (r, c), by swapping
+// off-diagonal blocks of halving size.
+static void transpose_bits(std::array<uint32_t, 32>& rows) {
+    uint32_t mask = 0x0000FFFFu;
+    for (int width = 16; width != 0; width >>= 1, mask ^= mask << width) {
+        for (int k = 0; k < 32; k = (k + width + 1) & ~width) {
+            uint32_t swapped = ((rows[k] >> width) ^ rows[k + width]) & mask;
+            rows[k + width] ^= swapped;
+            rows[k] ^= swapped << width;
+        }
+    }
+}
+
+// Same rectangles as mesh_greedy, from bitmasks instead of per-block lookups. Opaque occupancy is
+// kept as one 64-bit column per (u, v) along each axis, padded to 34 bits, so exposed faces for a
+// whole column are col & ~(col >> 1) (or << 1 for the negative side). Those bits are sorted into
+// 32x32 planes per block and slice, and merged with bit scans over 32-bit rows. See-through blocks
+// are rare, so their faces take the per-block path straight into the planes.
+static void mesh_binary(const PaddedSection& padded, const RowMasks& masks, ChunkMeshData& mesh) {
+    constexpr int size = ChunkSection::SIZE;
+    using Columns = std::array<std::array<uint64_t, size>, size>;
+    using Planes = std::array<std::array<uint32_t, size>, size>;
+
+    // Indexed [axis][v][u], with bit p + 1 holding the block at p along the axis.
+    std::array<Columns, 3> opaque;
+    std::array<Planes, (size_t)Block::COUNT> planes;
+    std::array<uint32_t, (size_t)Block::COUNT> used_slices;
+    std::vector<std::array<int, 3>> see_through;
+
+    // The y and z columns are 32x32 bit transposes of the row masks along x.
+    const Planes& rows = masks.opaque;
+    for (int y = 0; y < size; ++y) {
+        for (int z = 0; z < size; ++z) {
+            opaque[0][z][y] = (uint64_t)rows[y][z] << 1;
+
+            for (uint32_t see_through_bits = masks.see_through[y][z]; see_through_bits != 0; see_through_bits &= see_through_bits - 1) {
+                see_through.push_back({std::countr_zero(see_through_bits), y, z});
+            }
+        }
+    }
+
+    std::array<uint32_t, size> transposed;
+    for (int z = 0; z < size; ++z) {
+        for (int y = 0; y < size; ++y) {
+            transposed[y] = rows[y][z];
+        }
+
+        transpose_bits(transposed);
+        for (int x = 0; x < size; ++x) {
+            opaque[1][x][z] = (uint64_t)transposed[x] << 1;
+        }
+    }
+
+    for (int y = 0; y < size; ++y) {
+        transposed = rows[y];
+        transpose_bits(transposed);
+        for (int x = 0; x < size; ++x) {
+            opaque[2][y][x] = (uint64_t)transposed[x] << 1;
+        }
+    }
+
+    // Padding bits: the x ends sit next to each row, the y and z ends come from classifying the
+    // border rows and spreading their bits over the columns they cap.
+    for (int y = 0; y < size; ++y) {
+        for (int z = 0; z < size; ++z) {
+            const Block* row = &padded.blocks[PaddedSection::index(0, y, z)];
+            opaque[0][z][y] |= (uint64_t)is_opaque(row[-1]) | (uint64_t)is_opaque(row[size]) << (size + 1);
+        }
+    }
+
+    for (int b = 0; b < size; ++b) {
+        uint32_t low, high, unused;
+        classify_row(&padded.blocks[PaddedSection::index(0, -1, b)], low, unused);
+        classify_row(&padded.blocks[PaddedSection::index(0, size, b)], high, unused);
+        for (int x = 0; x < size; ++x) {
+            opaque[1][x][b] |= (uint64_t)((low >> x) & 1) | (uint64_t)((high >> x) & 1) << (size + 1);
+        }
+
+        classify_row(&padded.blocks[PaddedSection::index(0, b, -1)], low, unused);
+        classify_row(&padded.blocks[PaddedSection::index(0, b, size)], high, unused);
+        for (int x = 0; x < size; ++x) {
+            opaque[2][b][x] |= (uint64_t)((low >> x) & 1) | (uint64_t)((high >> x) & 1) << (size + 1);
+        }
+    }
+
+    for (size_t face = 0; face < FACE_COUNT; ++face) {
+        const std::array<int, 3>& direction = FACE_DIRECTIONS[face];
+        int axis = (int)face / 2;
+        int u = (axis + 1) % 3;
+        int v = (axis + 2) % 3;
+        bool positive = face % 2 == 0;
+
+        used_slices.fill(0);
+
+        std::array<int, 3> position;
+        for (int j = 0; j < size; ++j) {
+            position[v] = j;
+            for (int i = 0; i < size; ++i) {
+                position[u] = i;
+
+                uint64_t column = opaque[axis][j][i];
+                uint64_t exposed = positive ? column & ~(column >> 1) : column & ~(column << 1);
+                uint32_t bits = (uint32_t)(exposed >> 1);
+
+                while (bits != 0) {
+                    int slice = std::countr_zero(bits);
+                    bits &= bits - 1;
+
+                    position[axis] = slice;
+                    size_t block = (size_t)padded.get(position[0], position[1], position[2]);
+                    if (!(used_slices[block] & (1u << slice))) {
+                        used_slices[block] |= 1u << slice;
+                        planes[block][slice].fill(0);
+                    }
+
+                    planes[block][slice][j] |= 1u << i;
+                }
+            }
+        }
+
+        for (const std::array<int, 3>& cell : see_through) {
+            Block block = padded.get(cell[0], cell[1], cell[2]);
+            Block neighbour = padded.get(cell[0] + direction[0], cell[1] + direction[1], cell[2] + direction[2]);
+            if (!is_face_visible(block, neighbour)) {
+                continue;
+            }
+
+            int slice = cell[axis];
+            if (!(used_slices[(size_t)block] & (1u << slice))) {
+                used_slices[(size_t)block] |= 1u << slice;
+                planes[(size_t)block][slice].fill(0);
+            }
+
+            planes[(size_t)block][slice][cell[v]] |= 1u << cell[u];
+        }
+
+        for (size_t block = 0; block < (size_t)Block::COUNT; ++block) {
+            for (uint32_t slices = used_slices[block]; slices != 0; slices &= slices - 1) {
+                int slice = std::countr_zero(slices);
+                std::array<uint32_t, size>& rows = planes[block][slice];
+
+                for (int j = 0; j < size; ++j) {
+                    while (rows[j] != 0) {
+                        int start = std::countr_zero(rows[j]);
+                        int width = std::countr_one(rows[j] >> start);
+                        uint32_t run = (width == size ? ~0u : (1u << width) - 1) << start;
+
+                        int height = 1;
+                        while (j + height < size && (rows[j + height] & run) == run) {
+                            rows[j + height] &= ~run;
+                            ++height;
+                        }
+
+                        rows[j] &= ~run;
+
+                        position[axis] = slice;
+                        position[u] = start;
+                        position[v] = j;
+                        std::array<int, 3> extent = {1, 1, 1};
+                        extent[u] = width;
+                        extent[v] = height;
+                        emit_quad(mesh, position, extent, (Face)face, (Block)block);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static uint8_t count_opaque_layers(const RowMasks& masks) {
+    for (int y = 0; y < ChunkSection::SIZE; ++y) {
+        for (int z = 0; z < ChunkSection::SIZE; ++z) {
+            if (masks.opaque[y][z] != ~0u) {
+                return (uint8_t)y;
+            }
+        }
+    }
+
+    return (uint8_t)ChunkSection::SIZE;
+}
+
+// Flood fills each region of non-opaque blocks and records which faces of the section it touches;
+// any two faces touched by the same region can see each other through the section. The fill works
+// on rows of 32 blocks along x held in one word, so whole runs are claimed at once.
+static uint16_t compute_face_connections(const RowMasks& masks) {
+    constexpr int SIZE = ChunkSection::SIZE;
+    constexpr size_t ROW_COUNT = (size_t)SIZE * SIZE;
+    constexpr uint32_t LAST_BIT = 1u << (SIZE - 1);
+
+    // Rows are indexed by y * SIZE + z.
+    std::array<uint32_t, ROW_COUNT> open;
+    std::array<uint32_t, ROW_COUNT> visited = {};
+    uint32_t any_open = 0;
+    uint32_t all_open = ~0u;
+    for (int y = 0; y < SIZE; ++y) {
+        for (int z = 0; z < SIZE; ++z) {
+            uint32_t row = ~masks.opaque[y][z];
+            open[(size_t)y * SIZE + (size_t)z] = row;
+            any_open |= row;
+            all_open &= row;
+        }
+    }
+
+    // Solid sections and sections of nothing but air or leaves need no fill.
+    if (any_open == 0) {
+        return 0;
+    }
+
+    if (all_open == ~0u) {
+        return ALL_FACE_CONNECTIONS;
+    }
+
+    struct Span {
+        size_t row;
+        uint32_t seed;
+    };
+
+    uint16_t connections = 0;
+    std::vector<Span> stack;
+    for (size_t start = 0; start < ROW_COUNT && connections != ALL_FACE_CONNECTIONS; ++start) {
+        while (uint32_t unvisited = open[start] & ~visited[start]) {
+            uint8_t faces = 0;
+            stack.push_back(Span {start, unvisited & (0u - unvisited)});
+
+            while (!stack.empty()) {
+                Span span = stack.back();
+                stack.pop_back();
+
+                // Runs are always claimed whole, so a visited seed means its run is done.
+                uint32_t run = span.seed & ~visited[span.row];
+                if (run == 0) {
+                    continue;
+                }
+
+                uint32_t previous;
+                do {
+                    previous = run;
+                    run |= ((run << 1) | (run >> 1)) & open[span.row];
+                } while (run != previous);
+
+                visited[span.row] |= run;
+
+                int y = (int)(span.row / SIZE);
+                int z = (int)(span.row % SIZE);
+                faces |= (uint8_t)(((run & LAST_BIT) != 0) << (size_t)Face::East);
+                faces |= (uint8_t)(((run & 1u) != 0) << (size_t)Face::West);
+                faces |= (uint8_t)((y == SIZE - 1) << (size_t)Face::Up);
+                faces |= (uint8_t)((y == 0) << (size_t)Face::Down);
+                faces |= (uint8_t)((z == SIZE - 1) << (size_t)Face::South);
+                faces |= (uint8_t)((z == 0) << (size_t)Face::North);
+
+                auto spread = [&](bool inside, size_t row) {
+                    if (inside) {
+                        uint32_t seed = run & open[row] & ~visited[row];
+                        if (seed != 0) {
+                            stack.push_back(Span {row, seed});
+                        }
+                    }
+                };
+
+                spread(y > 0, span.row - SIZE);
+                spread(y < SIZE - 1, span.row + SIZE);
+                spread(z > 0, span.row - 1);
+                spread(z < SIZE - 1, span.row + 1);
+            }
+
+            for (size_t a = 0; a < FACE_COUNT; ++a) {
+                for (size_t b = a + 1; b < FACE_COUNT; ++b) {
+                    if ((faces >> a & 1) && (faces >> b & 1)) {
+                        connections |= face_connection_bit((Face)a, (Face)b);
+                    }
+                }
+            }
+        }
+    }
+
+    return connections;
+}
+
+// Replaces each cell of 2^lod blocks with a single block in the corner of a coarse section: a
+// cell is solid when at least half of it is, and takes the highest block in it so hillsides keep
+// their grass. Everything outside the coarse section stays air, border included, so the coarse
+// mesh is closed on all six sides. Those border faces act as skirts, hiding the cracks where it
+// meets a neighbour meshed at another level.
+static void downsample(const PaddedSection& padded, unsigned lod, PaddedSection& coarse) {
+    coarse.blocks.fill(Block::Air);
+
+    const int scale = 1 << lod;
+    const int size = ChunkSection::SIZE >> lod;
+
+    for (int cy = 0; cy < size; ++cy) {
+        for (int cz = 0; cz < size; ++cz) {
+            for (int cx = 0; cx < size; ++cx) {
+                Block top = Block::Air;
+                int filled = 0;
+                for (int y = scale - 1; y >= 0; --y) {
+                    for (int z = 0; z < scale; ++z) {
+                        for (int x = 0; x < scale; ++x) {
+                            Block block = padded.get(cx * scale + x, cy * scale + y, cz * scale + z);
+                            if (block == Block::Air) {
+                                continue;
+                            }
+
+                            ++filled;
+                            if (top == Block::Air) {
+                                top = block;
+                            }
+                        }
+                    }
+                }
+
+                if (2 * filled >= scale * scale * scale) {
+                    coarse.blocks[PaddedSection::index(cx, cy, cz)] = top;
+                }
+            }
+        }
+    }
+}
+
+static void mesh_blocks(const PaddedSection& padded, const RowMasks& masks, ChunkMeshData& mesh, ChunkMesher::Mode mode) {
+    switch (mode) {
+        case ChunkMesher::Mode::Naive:
+            mesh_naive(padded, mesh);
+            break;
+        case ChunkMesher::Mode::Greedy:
+            mesh_greedy(padded, mesh);
+            break;
+        case ChunkMesher::Mode::Binary:
+            mesh_binary(padded, masks, mesh);
+            break;
+        default:
+            break;
+    }
+}
+
+void ChunkMesher::mesh(const PaddedSection& padded, ChunkMeshData& mesh, Mode mode, unsigned lod, bool culling_data) {
+    assert(lod <= MAX_LOD);
+
+    mesh.vertices.clear();
+    mesh.opaque_layers = 0;
+    mesh.face_connections = 0;
+    mesh.has_culling_data = culling_data;
+
+    RowMasks masks;
+    if (lod == 0 || culling_data) {
+        classify_rows(padded, masks);
+    }
+
+    if (culling_data) {
+        mesh.opaque_layers = count_opaque_layers(masks);
+        mesh.face_connections = compute_face_connections(masks);
+    }
+
+    if (lod == 0) {
+        mesh_blocks(padded, masks, mesh, mode);
+        return;
+    }
+
+    std::unique_ptr<PaddedSection> coarse = std::make_unique<PaddedSection>();
+    downsample(padded, lod, *coarse);
+    classify_rows(*coarse, masks);
+    mesh_blocks(*coarse, masks, mesh, mode);
+
+    for (Vertex& vertex : mesh.vertices) {
+        vertex.data[0] |= (GLuint)lod << Vertex::LOD_SHIFT;
+    }
+}
\ No newline at end of file
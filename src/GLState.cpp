@@ -0,0 +1,245 @@
+#include "GLState.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+GLState::GLState() {
+    invalidate();
+}
+
+void GLState::invalidate() {
+    program = UNKNOWN;
+    vertex_array = UNKNOWN;
+    buffers.fill(UNKNOWN);
+    other_buffer_target = UNKNOWN_ENUM;
+    active_texture_unit = UNKNOWN;
+    textures.fill(TextureBinding {UNKNOWN_ENUM, UNKNOWN});
+
+    capabilities.fill(Tristate::Unknown);
+    depth_func = UNKNOWN_ENUM;
+    depth_mask = Tristate::Unknown;
+    blend_source = UNKNOWN_ENUM;
+    blend_destination = UNKNOWN_ENUM;
+    cull_face = UNKNOWN_ENUM;
+    front_face = UNKNOWN_ENUM;
+    viewport.fill(-1);
+}
+
+void GLState::begin_frame() {
+    frame_counters = counters;
+    counters = Counters();
+}
+
+void GLState::use_program(GLuint new_program) {
+    if (program == new_program) {
+        ++counters.skipped;
+        return;
+    }
+
+    glUseProgram(new_program);
+    program = new_program;
+    ++counters.binds;
+}
+
+void GLState::bind_vertex_array(GLuint new_vertex_array) {
+    if (vertex_array == new_vertex_array) {
+        ++counters.skipped;
+        return;
+    }
+
+    glBindVertexArray(new_vertex_array);
+    vertex_array = new_vertex_array;
+    ++counters.binds;
+}
+
+size_t GLState::get_buffer_slot(GLenum target) {
+    auto it = std::find(BUFFER_TARGETS.begin(), BUFFER_TARGETS.end(), target);
+    if (it != BUFFER_TARGETS.end()) {
+        return (size_t)(it - BUFFER_TARGETS.begin());
+    }
+
+    size_t slot = BUFFER_TARGETS.size();
+    if (other_buffer_target != target) {
+        other_buffer_target = target;
+        buffers[slot] = UNKNOWN;
+    }
+
+    return slot;
+}
+
+void GLState::bind_buffer(GLenum target, GLuint buffer) {
+    if (target == GL_ELEMENT_ARRAY_BUFFER) {
+        glBindBuffer(target, buffer);
+        ++counters.binds;
+        return;
+    }
+
+    GLuint& bound = buffers[get_buffer_slot(target)];
+    if (bound == buffer) {
+        ++counters.skipped;
+        return;
+    }
+
+    glBindBuffer(target, buffer);
+    bound = buffer;
+    ++counters.binds;
+}
+
+void GLState::bind_buffer_base(GLenum target, GLuint index, GLuint buffer) {
+    glBindBufferBase(target, index, buffer);
+    if (target != GL_ELEMENT_ARRAY_BUFFER) {
+        buffers[get_buffer_slot(target)] = buffer;
+    }
+
+    ++counters.binds;
+}
+
+void GLState::set_active_texture(GLuint unit) {
+    if (active_texture_unit == unit) {
+        return;
+    }
+
+    glActiveTexture(GL_TEXTURE0 + unit);
+    active_texture_unit = unit;
+    ++counters.state_changes;
+}
+
+// Only the most recent target per unit is remembered; binding another target on the same unit
+// costs a redundant bind later, never a missed one.
+void GLState::bind_texture(GLuint unit, GLenum target, GLuint texture) {
+    assert(unit < TEXTURE_UNITS);
+
+    TextureBinding& bound = textures[unit];
+    if (bound.target == target && bound.texture == texture) {
+        ++counters.skipped;
+        return;
+    }
+
+    set_active_texture(unit);
+    glBindTexture(target, texture);
+    bound = TextureBinding {target, texture};
+    ++counters.binds;
+}
+
+void GLState::set_enabled(GLenum capability, bool enabled) {
+    auto it = std::find(CAPABILITIES.begin(), CAPABILITIES.end(), capability);
+    assert(it != CAPABILITIES.end());
+
+    Tristate& current = capabilities[(size_t)(it - CAPABILITIES.begin())];
+    Tristate wanted = enabled ? Tristate::On : Tristate::Off;
+    if (current == wanted) {
+        ++counters.skipped;
+        return;
+    }
+
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+
+    current = wanted;
+    ++counters.state_changes;
+}
+
+void GLState::set_depth_func(GLenum func) {
+    if (depth_func == func) {
+        ++counters.skipped;
+        return;
+    }
+
+    glDepthFunc(func);
+    depth_func = func;
+    ++counters.state_changes;
+}
+
+void GLState::set_depth_mask(bool mask) {
+    Tristate wanted = mask ? Tristate::On : Tristate::Off;
+    if (depth_mask == wanted) {
+        ++counters.skipped;
+        return;
+    }
+
+    glDepthMask(mask ? GL_TRUE : GL_FALSE);
+    depth_mask = wanted;
+    ++counters.state_changes;
+}
+
+void GLState::set_blend_func(GLenum source, GLenum destination) {
+    if (blend_source == source && blend_destination == destination) {
+        ++counters.skipped;
+        return;
+    }
+
+    glBlendFunc(source, destination);
+    blend_source = source;
+    blend_destination = destination;
+    ++counters.state_changes;
+}
+
+void GLState::set_cull_face(GLenum face) {
+    if (cull_face == face) {
+        ++counters.skipped;
+        return;
+    }
+
+    glCullFace(face);
+    cull_face = face;
+    ++counters.state_changes;
+}
+
+void GLState::set_front_face(GLenum winding) {
+    if (front_face == winding) {
+        ++counters.skipped;
+        return;
+    }
+
+    glFrontFace(winding);
+    front_face = winding;
+    ++counters.state_changes;
+}
+
+void GLState::set_viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    std::array<GLint, 4> wanted = {x, y, (GLint)width, (GLint)height};
+    if (viewport == wanted) {
+        ++counters.skipped;
+        return;
+    }
+
+    glViewport(x, y, width, height);
+    viewport = wanted;
+    ++counters.state_changes;
+}
+
+void GLState::forget_program(GLuint old_program) {
+    if (program == old_program) {
+        program = UNKNOWN;
+    }
+}
+
+void GLState::forget_vertex_array(GLuint old_vertex_array) {
+    if (vertex_array == old_vertex_array) {
+        vertex_array = UNKNOWN;
+    }
+}
+
+void GLState::forget_buffer(GLuint old_buffer) {
+    for (GLuint& buffer : buffers) {
+        if (buffer == old_buffer) {
+            buffer = UNKNOWN;
+        }
+    }
+}
+
+void GLState::forget_texture(GLuint old_texture) {
+    for (TextureBinding& binding : textures) {
+        if (binding.texture == old_texture) {
+            binding.texture = UNKNOWN;
+        }
+    }
+}
+
+void GLState::count_draw(size_t commands) {
+    ++counters.draw_calls;
+    counters.draw_commands += commands;
+}
\ No newline at end of file
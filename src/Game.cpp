@@ -2,13 +2,24 @@
 
 #include <stdexcept>
 #include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
 
 #include "Renderer.hpp"
+#include "World.hpp"
+#include "math/Matrix.hpp"
+#include "math/pi.hpp"
 
 void Game::create_glfw_window() {
     assert(glfw_window == nullptr);
 
     glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_VISIBLE, options.bench ? GLFW_FALSE : GLFW_TRUE);
 
     glfw_window = glfwCreateWindow(WIDTH, HEIGHT, "minecraft", NULL, NULL);
     if (!glfw_window) {
@@ -31,18 +42,271 @@ void Game::loop() {
         throw std::runtime_error("failed to load GLAD");
     }
 
-    glfwSwapInterval(1);
-    glfwSetInputMode(glfw_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    if (options.bench) {
+        glfwSwapInterval(0);
+    } else {
+        glfwSwapInterval(1);
+        glfwSetInputMode(glfw_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    }
 
     {
-        Renderer renderer;
-        while (!glfwWindowShouldClose(glfw_window)) {
-            glfwPollEvents();
-            renderer.draw();
-            glfwSwapBuffers(glfw_window);
+        World world;
+        world.generate(0, 0, WORLD_RADIUS);
+
+        Renderer renderer(world);
+        if (options.bench) {
+            run_bench(renderer);
+        } else {
+            run_interactive(renderer);
         }
     }
     
     glfwDestroyWindow(glfw_window);
     glfwTerminate();
+}
+
+void Game::handle_input(Renderer& renderer, int width, int height) {
+    Camera& camera = renderer.get_camera();
+
+    double mouse_x, mouse_y;
+    glfwGetCursorPos(glfw_window, &mouse_x, &mouse_y);
+    mouse_x = 2.0 * (mouse_x / width) - 1.0;
+    mouse_y = 1.0 - 2.0 * (mouse_y / height);
+
+    camera.set_rotation(mouse_x, mouse_y);
+
+    math::Vector4f movement;
+    if (glfwGetKey(glfw_window, GLFW_KEY_W) == GLFW_PRESS) {
+        movement.z() += 1.0f;
+    }
+
+    if (glfwGetKey(glfw_window, GLFW_KEY_S) == GLFW_PRESS) {
+        movement.z() -= 1.0f;
+    }
+
+    if (glfwGetKey(glfw_window, GLFW_KEY_D) == GLFW_PRESS) {
+        movement.x() += 1.0f;
+    }
+
+    if (glfwGetKey(glfw_window, GLFW_KEY_A) == GLFW_PRESS) {
+        movement.x() -= 1.0f;
+    }
+
+    math::Vector3d view_position = camera.get_position();
+    if (!movement.is_zero()) {
+        math::Vector4f direction = math::rotation_y(mouse_x) * movement.normalize();
+        view_position += math::Vector3d((double)direction.x(), 0.0, (double)direction.z()) * 0.08;
+    }
+
+    if (glfwGetKey(glfw_window, GLFW_KEY_SPACE) == GLFW_PRESS) {
+        view_position.y() += 0.08;
+    }
+
+    if (glfwGetKey(glfw_window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS) {
+        view_position.y() -= 0.08;
+    }
+
+    camera.set_position(view_position);
+
+    // G cycles through the mesher modes and remeshes everything, for comparing them.
+    bool mesher_key = glfwGetKey(glfw_window, GLFW_KEY_G) == GLFW_PRESS;
+    if (mesher_key && !mesher_key_down) {
+        size_t next_mode = ((size_t)renderer.get_mesher_mode() + 1) % (size_t)ChunkMesher::Mode::COUNT;
+        renderer.set_mesher_mode((ChunkMesher::Mode)next_mode);
+    }
+
+    mesher_key_down = mesher_key;
+
+    // O toggles occlusion culling.
+    bool occlusion_key = glfwGetKey(glfw_window, GLFW_KEY_O) == GLFW_PRESS;
+    if (occlusion_key && !occlusion_key_down) {
+        renderer.set_occlusion_culling(!renderer.is_occlusion_culling());
+    }
+
+    occlusion_key_down = occlusion_key;
+
+    // C toggles cave culling.
+    bool cave_key = glfwGetKey(glfw_window, GLFW_KEY_C) == GLFW_PRESS;
+    if (cave_key && !cave_key_down) {
+        renderer.set_cave_culling(!renderer.is_cave_culling());
+    }
+
+    cave_key_down = cave_key;
+
+    // L toggles level of detail.
+    bool lod_key = glfwGetKey(glfw_window, GLFW_KEY_L) == GLFW_PRESS;
+    if (lod_key && !lod_key_down) {
+        renderer.set_lod_enabled(!renderer.is_lod_enabled());
+    }
+
+    lod_key_down = lod_key;
+}
+
+void Game::run_interactive(Renderer& renderer) {
+    double title_time = glfwGetTime();
+    size_t title_frames = 0;
+    while (!glfwWindowShouldClose(glfw_window)) {
+        glfwPollEvents();
+
+        int framebuffer_width, framebuffer_height;
+        glfwGetFramebufferSize(glfw_window, &framebuffer_width, &framebuffer_height);
+
+        handle_input(renderer, framebuffer_width, framebuffer_height);
+        renderer.draw(framebuffer_width, framebuffer_height);
+        glfwSwapBuffers(glfw_window);
+
+        // Once a second, show the frame rate and the GL call counts of the last frame.
+        ++title_frames;
+        double now = glfwGetTime();
+        if (now - title_time >= 1.0) {
+            const GLState::Counters& counters = renderer.get_frame_counters();
+            std::string title = "minecraft - " + std::to_string((size_t)(title_frames / (now - title_time))) + " fps, "
+                + std::to_string(counters.draw_calls) + " draw calls (" + std::to_string(counters.draw_commands) + " draws), "
+                + std::to_string(counters.binds) + " binds, " + std::to_string(counters.state_changes) + " state changes, "
+                + std::to_string(counters.skipped) + " skipped";
+            if (const GpuProfiler::Pass* gpu_total = renderer.get_gpu_profiler().find_pass("total")) {
+                title += ", " + std::to_string(gpu_total->average_ms) + " ms gpu";
+            }
+            glfwSetWindowTitle(glfw_window, title.c_str());
+
+            title_time = now;
+            title_frames = 0;
+        }
+    }
+}
+
+// Frame times include a glFinish, so they cover the GPU work too; on a software rasterizer such
+// as llvmpipe that is where most of the frame goes.
+void Game::run_bench(Renderer& renderer) {
+    GLuint framebuffer, color_buffer, depth_buffer;
+    glGenFramebuffers(1, &framebuffer);
+    glGenRenderbuffers(1, &color_buffer);
+    glGenRenderbuffers(1, &depth_buffer);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, color_buffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, WIDTH, HEIGHT);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth_buffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, WIDTH, HEIGHT);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_buffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth_buffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        throw std::runtime_error("failed to create benchmark framebuffer");
+    }
+
+    Camera& camera = renderer.get_camera();
+    auto follow_path = [this, &camera](size_t frame) {
+        double angle = 2.0 * math::pi<double>() * (double)frame / (double)std::max<size_t>(options.bench_frames, 1);
+        camera.set_position(math::Vector3d(std::cos(angle) * BENCH_PATH_RADIUS, BENCH_PATH_HEIGHT, std::sin(angle) * BENCH_PATH_RADIUS));
+        camera.set_rotation((float)-angle, BENCH_PATH_PITCH);
+    };
+
+    // Meshing runs on worker threads; wait for all of it so every run measures the same scene.
+    follow_path(0);
+    while (renderer.has_pending_meshes()) {
+        renderer.draw(WIDTH, HEIGHT);
+        glFinish();
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto elapsed_ms = [](Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    std::vector<double> frame_ms;
+    frame_ms.reserve(options.bench_frames);
+    Renderer::FrameStats stage_totals;
+    double finish_total_ms = 0.0;
+    size_t lod_remeshes = 0;
+    GLState::Counters counter_totals;
+
+    for (size_t frame = 0; frame < options.bench_frames; ++frame) {
+        // Sections that change level along the path are meshed before the clock starts, so the
+        // timed frames never depend on how the mesh threads happen to be scheduled.
+        follow_path(frame);
+        lod_remeshes += renderer.sync_meshes();
+
+        Clock::time_point frame_start = Clock::now();
+        renderer.draw(WIDTH, HEIGHT);
+
+        Clock::time_point finish_start = Clock::now();
+        glFinish();
+        Clock::time_point frame_end = Clock::now();
+
+        frame_ms.push_back(elapsed_ms(frame_start, frame_end));
+        finish_total_ms += elapsed_ms(finish_start, frame_end);
+
+        const Renderer::FrameStats& stats = renderer.get_frame_stats();
+        stage_totals.upload_ms += stats.upload_ms;
+        stage_totals.cull_ms += stats.cull_ms;
+        stage_totals.submit_ms += stats.submit_ms;
+        stage_totals.visible_sections += stats.visible_sections;
+        stage_totals.occluded_sections += stats.occluded_sections;
+        stage_totals.cave_culled_sections += stats.cave_culled_sections;
+        for (size_t lod = 0; lod < stats.lod_sections.size(); ++lod) {
+            stage_totals.lod_sections[lod] += stats.lod_sections[lod];
+        }
+    }
+
+    // Counters are rolled over at the start of each draw, so one more frame is needed for the last.
+    renderer.draw(WIDTH, HEIGHT);
+    glFinish();
+    counter_totals = renderer.get_frame_counters();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteRenderbuffers(1, &color_buffer);
+    glDeleteRenderbuffers(1, &depth_buffer);
+
+    if (frame_ms.empty()) {
+        return;
+    }
+
+    double frames = (double)frame_ms.size();
+    double total_ms = 0.0;
+    for (double ms : frame_ms) {
+        total_ms += ms;
+    }
+
+    std::sort(frame_ms.begin(), frame_ms.end());
+    size_t p99_index = (size_t)std::ceil(0.99 * frames) - 1;
+
+    std::cout << "bench: " << frame_ms.size() << " frames at " << WIDTH << "x" << HEIGHT
+        << " on " << (const char*)glGetString(GL_RENDERER) << std::endl;
+    std::cout << "frame ms: min " << frame_ms.front() << ", avg " << total_ms / frames << ", p99 " << frame_ms[p99_index]
+        << ", max " << frame_ms.back() << std::endl;
+    std::cout << "stage ms per frame: upload " << stage_totals.upload_ms / frames << ", cull " << stage_totals.cull_ms / frames
+        << ", submit " << stage_totals.submit_ms / frames << ", finish " << finish_total_ms / frames << std::endl;
+    std::cout << "sections per frame: " << (double)stage_totals.visible_sections / frames << " drawn, "
+        << (double)stage_totals.cave_culled_sections / frames << " cave culled, " << (double)stage_totals.occluded_sections / frames
+        << " occluded" << std::endl;
+    std::cout << "drawn sections per level of detail:";
+    for (size_t lod = 0; lod < stage_totals.lod_sections.size(); ++lod) {
+        std::cout << (lod == 0 ? " " : ", ") << (double)stage_totals.lod_sections[lod] / frames;
+    }
+
+    std::cout << std::endl;
+    std::cout << "level of detail remeshes: " << lod_remeshes << ", done between timed frames" << std::endl;
+    std::cout << "gl calls in the last frame: " << counter_totals.draw_calls << " draw calls (" << counter_totals.draw_commands
+        << " draws), " << counter_totals.binds << " binds, " << counter_totals.state_changes << " state changes, "
+        << counter_totals.skipped << " skipped" << std::endl;
+
+    const GpuProfiler& gpu_profiler = renderer.get_gpu_profiler();
+    std::cout << "gpu ms, average of the last " << GpuProfiler::AVERAGE_FRAMES << " frames:";
+    for (const GpuProfiler::Pass& pass : gpu_profiler.get_passes()) {
+        std::cout << " " << pass.name << " " << pass.average_ms;
+    }
+
+    std::cout << " (" << gpu_profiler.get_dropped_frames() << " frames dropped)" << std::endl;
+
+    if (!options.gpu_csv_filename.empty()) {
+        std::ofstream csv(options.gpu_csv_filename);
+        if (!csv) {
+            throw std::runtime_error("failed to open " + options.gpu_csv_filename);
+        }
+
+        gpu_profiler.write_csv(csv);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "GpuProfiler.hpp"
+
+#include <cassert>
+
+GpuProfiler::~GpuProfiler() noexcept {
+    for (Frame& frame : frames) {
+        if (!frame.queries.empty()) {
+            glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+        }
+    }
+}
+
+void GpuProfiler::begin_frame() {
+    assert(open_samples.empty());
+
+    if (frame_started) {
+        current_frame = (current_frame + 1) % FRAME_LATENCY;
+    }
+
+    // The slot about to be reused holds the oldest frame still in flight.
+    Frame& frame = frames[current_frame];
+    resolve(frame);
+
+    frame.number = frame_number++;
+    frame.used_queries = 0;
+    frame.samples.clear();
+    frame_started = true;
+}
+
+size_t GpuProfiler::get_pass_index(std::string_view name) {
+    auto it = pass_indices.find(name);
+    if (it != pass_indices.end()) {
+        return it->second;
+    }
+
+    size_t index = passes.size();
+    passes.emplace_back().name = name;
+    pass_indices.emplace(name, index);
+    return index;
+}
+
+GLuint GpuProfiler::issue_timestamp(Frame& frame, size_t& query_index) {
+    if (frame.used_queries == frame.queries.size()) {
+        frame.queries.push_back(0);
+        glGenQueries(1, &frame.queries.back());
+    }
+
+    query_index = frame.used_queries++;
+    GLuint query = frame.queries[query_index];
+    glQueryCounter(query, GL_TIMESTAMP);
+    return query;
+}
+
+void GpuProfiler::begin_scope(std::string_view name) {
+    assert(frame_started);
+
+    Frame& frame = frames[current_frame];
+    Sample sample = {get_pass_index(name), 0, 0};
+    issue_timestamp(frame, sample.begin_query);
+
+    open_samples.push_back(frame.samples.size());
+    frame.samples.push_back(sample);
+}
+
+void GpuProfiler::end_scope() {
+    assert(!open_samples.empty());
+
+    Frame& frame = frames[current_frame];
+    Sample& sample = frame.samples[open_samples.back()];
+    open_samples.pop_back();
+
+    issue_timestamp(frame, sample.end_query);
+}
+
+void GpuProfiler::resolve(Frame& frame) {
+    if (frame.samples.empty()) {
+        return;
+    }
+
+    // Queries complete in submission order, so the last one being ready means they all are.
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[frame.used_queries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        ++dropped_frames;
+        return;
+    }
+
+    HistoryRow row = {frame.number, std::vector<double>(passes.size(), -1.0)};
+    for (const Sample& sample : frame.samples) {
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(frame.queries[sample.begin_query], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame.queries[sample.end_query], GL_QUERY_RESULT, &end);
+
+        // A pass entered several times in one frame reports its total.
+        double& ms = row.pass_ms[sample.pass];
+        ms = (ms < 0.0 ? 0.0 : ms) + (double)(end - begin) / 1e6;
+    }
+
+    for (size_t i = 0; i < passes.size(); ++i) {
+        if (row.pass_ms[i] < 0.0) {
+            continue;
+        }
+
+        Pass& pass = passes[i];
+        pass.last_ms = row.pass_ms[i];
+        if (pass.sample_count == AVERAGE_FRAMES) {
+            pass.sample_sum -= pass.samples[pass.next_sample];
+        } else {
+            ++pass.sample_count;
+        }
+
+        pass.samples[pass.next_sample] = pass.last_ms;
+        pass.sample_sum += pass.last_ms;
+        pass.next_sample = (pass.next_sample + 1) % AVERAGE_FRAMES;
+        pass.average_ms = pass.sample_sum / (double)pass.sample_count;
+    }
+
+    if (history.size() == HISTORY_FRAMES) {
+        history.pop_front();
+    }
+
+    history.push_back(std::move(row));
+}
+
+const GpuProfiler::Pass* GpuProfiler::find_pass(std::string_view name) const {
+    auto it = pass_indices.find(name);
+    return it != pass_indices.end() ? &passes[it->second] : nullptr;
+}
+
+void GpuProfiler::write_csv(std::ostream& stream) const {
+    stream << "frame";
+    for (const Pass& pass : passes) {
+        stream << ',' << pass.name;
+    }
+
+    stream << '\n';
+
+    for (const HistoryRow& row : history) {
+        stream << row.frame;
+        for (size_t i = 0; i < passes.size(); ++i) {
+            stream << ',';
+            if (i < row.pass_ms.size() && row.pass_ms[i] >= 0.0) {
+                stream << row.pass_ms[i];
+            }
+        }
+
+        stream << '\n';
+    }
+}
\ No newline at end of file
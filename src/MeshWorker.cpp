@@ -0,0 +1,75 @@
+#include "MeshWorker.hpp"
+
+#include <cassert>
+#include <utility>
+
+MeshWorker::MeshWorker(unsigned thread_count) {
+    if (thread_count == 0) {
+        unsigned hardware_threads = std::thread::hardware_concurrency();
+        thread_count = hardware_threads > 1 ? hardware_threads - 1 : 1;
+    }
+
+    for (unsigned i = 0; i < thread_count; ++i) {
+        threads.emplace_back(&MeshWorker::run, this);
+    }
+}
+
+MeshWorker::~MeshWorker() noexcept {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+
+    job_available.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void MeshWorker::submit(
+    uint64_t key, uint32_t version, uint32_t slot, std::unique_ptr<PaddedSection> blocks, ChunkMesher::Mode mode,
+    unsigned lod, bool culling_data
+) {
+    assert(slot <= Vertex::MAX_SLOT);
+
+    {
+        std::lock_guard lock(mutex);
+        jobs.push_back(Job {key, version, slot, std::move(blocks), mode, lod, culling_data});
+    }
+
+    job_available.notify_one();
+}
+
+void MeshWorker::poll(std::vector<Result>& results) {
+    std::lock_guard lock(mutex);
+    for (Result& result : finished) {
+        results.push_back(std::move(result));
+    }
+
+    finished.clear();
+}
+
+void MeshWorker::run() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(mutex);
+            job_available.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) {
+                return;
+            }
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        Result result {job.key, job.version, {}};
+        ChunkMesher::mesh(*job.blocks, result.mesh, job.mode, job.lod, job.culling_data);
+        for (Vertex& vertex : result.mesh.vertices) {
+            vertex.data[1] |= job.slot << Vertex::SLOT_SHIFT;
+        }
+
+        std::lock_guard lock(mutex);
+        finished.push_back(std::move(result));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include "OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "math/simd.hpp"
+
+// Points closer to the camera plane than this are clipped away, so projection never divides by
+// a w near zero.
+static constexpr float MIN_CLIP_W = 0.05f;
+// Occluders are written this fraction farther away than they are, so a box never hides itself.
+static constexpr float OCCLUDER_DEPTH_BIAS = 1e-3f;
+// A candidate is tested at the coarsest level where its bounds span at most this many texels.
+static constexpr int MAX_TEST_SPAN = 8;
+
+OcclusionBuffer::OcclusionBuffer() {
+    for (size_t level = 0; level < LEVEL_COUNT; ++level) {
+        levels[level].resize((WIDTH >> level) * (HEIGHT >> level));
+    }
+}
+
+void OcclusionBuffer::clear(const math::Matrix4f& new_view_projection) {
+    view_projection = new_view_projection;
+    std::fill(levels[0].begin(), levels[0].end(), 0.0f);
+}
+
+math::Vector4f OcclusionBuffer::to_clip(const math::Vector3f& point) const {
+    return view_projection * math::Vector4f(point.x(), point.y(), point.z(), 1.0f);
+}
+
+OcclusionBuffer::ScreenVertex OcclusionBuffer::to_screen(const math::Vector4f& clip) const {
+    float inverse_w = 1.0f / clip.w();
+    return ScreenVertex {
+        (clip.x() * inverse_w * 0.5f + 0.5f) * (float)WIDTH,
+        (clip.y() * inverse_w * 0.5f + 0.5f) * (float)HEIGHT,
+        inverse_w
+    };
+}
+
+// Only the faces pointing at the camera, which sits at the origin, can be nearest; each is
+// clipped against w = MIN_CLIP_W and drawn as a triangle fan.
+void OcclusionBuffer::rasterize_box(const math::Vector3f& min, const math::Vector3f& max) {
+    std::array<math::Vector4f, 8> corners;
+    for (size_t i = 0; i < 8; ++i) {
+        corners[i] = to_clip(math::Vector3f(
+            (i & 1) ? max.x() : min.x(),
+            (i & 2) ? max.y() : min.y(),
+            (i & 4) ? max.z() : min.z()
+        ));
+    }
+
+    for (size_t axis = 0; axis < 3; ++axis) {
+        size_t side;
+        if (min[axis] > 0.0f) {
+            side = 0;
+        } else if (max[axis] < 0.0f) {
+            side = 1;
+        } else {
+            continue;
+        }
+
+        size_t u = (axis + 1) % 3;
+        size_t v = (axis + 2) % 3;
+        std::array<math::Vector4f, 4> face = {
+            corners[side << axis],
+            corners[(side << axis) | ((size_t)1 << u)],
+            corners[(side << axis) | ((size_t)1 << u) | ((size_t)1 << v)],
+            corners[(side << axis) | ((size_t)1 << v)]
+        };
+
+        // Sutherland-Hodgman against a single plane: a quad becomes at most a pentagon.
+        std::array<ScreenVertex, 5> polygon;
+        size_t count = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            const math::Vector4f& current = face[i];
+            const math::Vector4f& next = face[(i + 1) % 4];
+            bool current_inside = current.w() >= MIN_CLIP_W;
+            bool next_inside = next.w() >= MIN_CLIP_W;
+
+            if (current_inside) {
+                polygon[count++] = to_screen(current);
+            }
+
+            if (current_inside != next_inside) {
+                float t = (MIN_CLIP_W - current.w()) / (next.w() - current.w());
+                polygon[count++] = to_screen(current + (next - current) * t);
+            }
+        }
+
+        for (size_t i = 2; i < count; ++i) {
+            rasterize_triangle(polygon[0], polygon[i - 1], polygon[i]);
+        }
+    }
+}
+
+void OcclusionBuffer::rasterize_triangle(ScreenVertex a, ScreenVertex b, ScreenVertex c) {
+    float area = (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+    if (area == 0.0f) {
+        return;
+    }
+
+    if (area < 0.0f) {
+        std::swap(b, c);
+        area = -area;
+    }
+
+    int min_x = std::max(0, (int)std::floor(std::min({a.x, b.x, c.x})));
+    int max_x = std::min((int)WIDTH - 1, (int)std::ceil(std::max({a.x, b.x, c.x})));
+    int min_y = std::max(0, (int)std::floor(std::min({a.y, b.y, c.y})));
+    int max_y = std::min((int)HEIGHT - 1, (int)std::ceil(std::max({a.y, b.y, c.y})));
+    if (min_x > max_x || min_y > max_y) {
+        return;
+    }
+
+    // Edge functions E = A x + B y + C, non-negative inside, evaluated at pixel centres.
+    std::array<float, 3> edge_a, edge_b, edge_c;
+    const std::array<ScreenVertex, 3> vertices = {a, b, c};
+    for (size_t i = 0; i < 3; ++i) {
+        const ScreenVertex& from = vertices[i];
+        const ScreenVertex& to = vertices[(i + 1) % 3];
+        edge_a[i] = from.y - to.y;
+        edge_b[i] = to.x - from.x;
+        edge_c[i] = from.x * to.y - from.y * to.x;
+    }
+
+    float inverse_area = 1.0f / area;
+    float depth_dx = ((b.inverse_depth - a.inverse_depth) * (c.y - a.y) - (c.inverse_depth - a.inverse_depth) * (b.y - a.y)) * inverse_area;
+    float depth_dy = ((c.inverse_depth - a.inverse_depth) * (b.x - a.x) - (b.inverse_depth - a.inverse_depth) * (c.x - a.x)) * inverse_area;
+    float depth_scale = 1.0f - OCCLUDER_DEPTH_BIAS;
+    float depth_c = (a.inverse_depth - depth_dx * a.x - depth_dy * a.y) * depth_scale;
+    depth_dx *= depth_scale;
+    depth_dy *= depth_scale;
+
+    std::vector<float>& depth = levels[0];
+
+#if defined(MATH_SIMD_SSE)
+    // WIDTH is a multiple of the vector width, so aligned blocks never run past a row.
+    int first_x = min_x - min_x % (int)math::simd::WIDTH;
+    std::array<float, math::simd::WIDTH> lane_offsets;
+    for (size_t lane = 0; lane < math::simd::WIDTH; ++lane) {
+        lane_offsets[lane] = (float)lane;
+    }
+
+    math::simd::WideFloat lanes = math::simd::load_wide(lane_offsets.data());
+    math::simd::WideFloat zero = math::simd::splat(0.0f);
+
+    for (int y = min_y; y <= max_y; ++y) {
+        float center_y = (float)y + 0.5f;
+        float* row = depth.data() + (size_t)y * WIDTH;
+
+        for (int x = first_x; x <= max_x; x += (int)math::simd::WIDTH) {
+            math::simd::WideFloat center_x = math::simd::add(lanes, math::simd::splat((float)x + 0.5f));
+
+            math::simd::WideFloat outside = zero;
+            for (size_t i = 0; i < 3; ++i) {
+                math::simd::WideFloat edge = math::simd::multiply_add(math::simd::splat(edge_a[i]), center_x, math::simd::splat(edge_b[i] * center_y + edge_c[i]));
+                outside = math::simd::bit_or(outside, math::simd::less_than(edge, zero));
+            }
+
+            if (math::simd::mask_bits(outside) == (1u << math::simd::WIDTH) - 1) {
+                continue;
+            }
+
+            math::simd::WideFloat triangle_depth = math::simd::multiply_add(math::simd::splat(depth_dx), center_x, math::simd::splat(depth_dy * center_y + depth_c));
+            math::simd::WideFloat current = math::simd::load_wide(row + x);
+            math::simd::store_wide(row + x, math::simd::select(outside, current, math::simd::max(current, triangle_depth)));
+        }
+    }
+#else
+    for (int y = min_y; y <= max_y; ++y) {
+        float center_y = (float)y + 0.5f;
+        float* row = depth.data() + (size_t)y * WIDTH;
+
+        for (int x = min_x; x <= max_x; ++x) {
+            float center_x = (float)x + 0.5f;
+
+            bool inside = true;
+            for (size_t i = 0; i < 3; ++i) {
+                inside &= edge_a[i] * center_x + edge_b[i] * center_y + edge_c[i] >= 0.0f;
+            }
+
+            if (inside) {
+                row[x] = std::max(row[x], depth_dx * center_x + depth_dy * center_y + depth_c);
+            }
+        }
+    }
+#endif
+}
+
+// Each texel keeps the farthest (smallest) depth of the four below it.
+void OcclusionBuffer::build_hierarchy() {
+    for (size_t level = 1; level < LEVEL_COUNT; ++level) {
+        const std::vector<float>& source = levels[level - 1];
+        std::vector<float>& destination = levels[level];
+        size_t source_width = WIDTH >> (level - 1);
+        size_t width = WIDTH >> level;
+        size_t height = HEIGHT >> level;
+
+        for (size_t y = 0; y < height; ++y) {
+            const float* top = source.data() + (2 * y) * source_width;
+            const float* bottom = top + source_width;
+            for (size_t x = 0; x < width; ++x) {
+                destination[y * width + x] = std::min(
+                    std::min(top[2 * x], top[2 * x + 1]),
+                    std::min(bottom[2 * x], bottom[2 * x + 1])
+                );
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::is_occluded(const math::Vector3f& min, const math::Vector3f& max) const {
+    float screen_min_x = (float)WIDTH, screen_min_y = (float)HEIGHT;
+    float screen_max_x = 0.0f, screen_max_y = 0.0f;
+    float nearest = 0.0f;
+
+    for (size_t i = 0; i < 8; ++i) {
+        math::Vector4f clip = to_clip(math::Vector3f(
+            (i & 1) ? max.x() : min.x(),
+            (i & 2) ? max.y() : min.y(),
+            (i & 4) ? max.z() : min.z()
+        ));
+
+        if (clip.w() < MIN_CLIP_W) {
+            return false;
+        }
+
+        ScreenVertex vertex = to_screen(clip);
+        screen_min_x = std::min(screen_min_x, vertex.x);
+        screen_min_y = std::min(screen_min_y, vertex.y);
+        screen_max_x = std::max(screen_max_x, vertex.x);
+        screen_max_y = std::max(screen_max_y, vertex.y);
+        nearest = std::max(nearest, vertex.inverse_depth);
+    }
+
+    int min_x = std::max(0, (int)std::floor(screen_min_x));
+    int max_x = std::min((int)WIDTH - 1, (int)std::ceil(screen_max_x));
+    int min_y = std::max(0, (int)std::floor(screen_min_y));
+    int max_y = std::min((int)HEIGHT - 1, (int)std::ceil(screen_max_y));
+    if (min_x > max_x || min_y > max_y) {
+        return false;
+    }
+
+    size_t level = 0;
+    while (level + 1 < LEVEL_COUNT && ((max_x >> level) - (min_x >> level) >= MAX_TEST_SPAN || (max_y >> level) - (min_y >> level) >= MAX_TEST_SPAN)) {
+        ++level;
+    }
+
+    const std::vector<float>& depth = levels[level];
+    size_t width = WIDTH >> level;
+    for (int y = min_y >> level; y <= max_y >> level; ++y) {
+        for (int x = min_x >> level; x <= max_x >> level; ++x) {
+            if (depth[(size_t)y * width + (size_t)x] <= nearest) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
\ No newline at end of file
@@ -1,37 +1,33 @@
 #include "Renderer.hpp"
 
-#include <cstddef>
-
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "ChunkSection.hpp"
 #include "math/Matrix.hpp"
+#include "math/Coordinates.hpp"
 #include "math/pi.hpp"
 
-struct Vertex {
-    GLfloat position[3];
-    GLfloat color[4];
-};
-
-Renderer::Renderer() {
-    glClearColor(0.1f, 0.15f, 0.3f, 1.0f);
+Renderer::Renderer(World& world) : world(world) {
+    glClearColor(FOG_COLOR[0], FOG_COLOR[1], FOG_COLOR[2], FOG_COLOR[3]);
 
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
+    gl_state.set_enabled(GL_DEPTH_TEST, true);
+    gl_state.set_depth_func(GL_LESS);
     glClearDepth(1.0f);
 
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-    Vertex vertices[] = {
-        (Vertex) {{-1.0f, -1.0f, 3.0f}, {0.0f, 0.0f, 0.0f, 1.0f}},
-        (Vertex) {{1.0f, -1.0f, 3.0f}, {1.0f, 0.0f, 0.0f, 1.0f}},
-        (Vertex) {{-1.0f, 1.0f, 3.0f}, {0.0f, 1.0f, 0.0f, 1.0f}},
-        (Vertex) {{-1.0f, -1.0f, 5.0f}, {0.0f, 0.0f, 1.0f, 1.0f}},
-        (Vertex) {{1.0f, 1.0f, 3.0f}, {1.0f, 1.0f, 0.0f, 1.0f}},
-        (Vertex) {{1.0f, -1.0f, 5.0f}, {1.0f, 0.0f, 1.0f, 1.0f}},
-        (Vertex) {{-1.0f, 1.0f, 5.0f}, {0.0f, 1.0f, 1.0f, 1.0f}},
-        (Vertex) {{1.0f, 1.0f, 5.0f}, {1.0f, 1.0f, 1.0f, 1.0f}},
-    };
-
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    // The mesher winds faces counter-clockwise from outside in right-handed world space; with +z
+    // pointing into the screen that appears clockwise once projected.
+    gl_state.set_enabled(GL_CULL_FACE, true);
+    gl_state.set_cull_face(GL_BACK);
+    gl_state.set_front_face(GL_CW);
 
     vertex_shader.load_from_file("../shaders/vertex.glsl");
     fragment_shader.load_from_file("../shaders/fragment.glsl");
@@ -39,109 +35,510 @@ Renderer::Renderer() {
     shader_program.attach_shader(std::move(fragment_shader));
     shader_program.link();
 
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
-
-    GLuint elements[] = {
-        0, 1, 5,
-        0, 3, 5,
-        0, 1, 4,
-        0, 2, 4,
-        0, 3, 6,
-        0, 2, 6,
-        1, 5, 7,
-        1, 4, 7,
-        2, 4, 7,
-        2, 6, 7,
-        3, 5, 7,
-        3, 6, 7
-    };
+    gl_state.use_program(shader_program.get_handle());
+    shader_program.set_uniform("u_section_offsets", 0);
+    shader_program.set_uniform("u_block_textures", (GLint)BLOCK_TEXTURE_UNIT);
+    shader_program.bind_uniform_block(FrameData::BLOCK_NAME, FrameData::BINDING);
+
+    glGenBuffers(1, &frame_data_buffer);
+    gl_state.bind_buffer(GL_UNIFORM_BUFFER, frame_data_buffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_STREAM_DRAW);
+    gl_state.bind_buffer_base(GL_UNIFORM_BUFFER, FrameData::BINDING, frame_data_buffer);
 
-    glGenBuffers(1, &EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(elements), elements, GL_STATIC_DRAW);
+    glGenBuffers(1, &section_offset_buffer);
+    gl_state.bind_buffer(GL_TEXTURE_BUFFER, section_offset_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, 4 * sizeof(GLfloat), nullptr, GL_STREAM_DRAW);
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-    glEnableVertexAttribArray(0);
+    glGenTextures(1, &section_offset_texture);
+    gl_state.bind_texture(0, GL_TEXTURE_BUFFER, section_offset_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, section_offset_buffer);
 
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
-    glEnableVertexAttribArray(1);
+    camera.set_position(math::Vector3d(0.0, 80.0, 0.0));
+    start_time = glfwGetTime();
 
-    glBindVertexArray(0);
+    remesh_all();
 }
 
 Renderer::~Renderer() noexcept {
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
-    glDeleteVertexArrays(1, &VAO);
+    gl_state.forget_texture(section_offset_texture);
+    gl_state.forget_buffer(section_offset_buffer);
+    gl_state.forget_buffer(frame_data_buffer);
+    glDeleteTextures(1, &section_offset_texture);
+    glDeleteBuffers(1, &section_offset_buffer);
+    glDeleteBuffers(1, &frame_data_buffer);
+}
+
+void Renderer::request_mesh(const math::Vector3i64& section, bool lod_only) {
+    std::unique_ptr<PaddedSection> blocks = std::make_unique<PaddedSection>();
+    ChunkMesher::gather(world, section, *blocks);
+
+    uint64_t key = math::pack_chunk_key(section);
+    auto [it, inserted] = section_meshes.try_emplace(key);
+    SectionMesh& mesh = it->second;
+    if (inserted) {
+        if (free_slots.empty()) {
+            if (slot_count > Vertex::MAX_SLOT) {
+                throw std::runtime_error("out of section slots");
+            }
+
+            mesh.slot = slot_count++;
+        } else {
+            mesh.slot = free_slots.back();
+            free_slots.pop_back();
+        }
+    }
+
+    if (!lod_only) {
+        mesh.culling_data_pending = true;
+    }
+
+    mesh.version = ++next_mesh_version;
+    mesh.lod = (uint8_t)select_lod(section, mesh.lod);
+    mesh_worker.submit(key, mesh.version, mesh.slot, std::move(blocks), mesher_mode, mesh.lod, mesh.culling_data_pending);
+    ++pending_meshes;
+}
+
+void Renderer::remesh_all() {
+    log_remesh = true;
+    for (const auto& [key, section] : world.get_sections()) {
+        if (!section->is_empty()) {
+            request_mesh(math::unpack_chunk_key(key));
+        }
+    }
+}
+
+unsigned Renderer::select_lod(const math::Vector3i64& section, unsigned current) const {
+    if (!lod_enabled) {
+        return 0;
+    }
+
+    const math::Vector3d& position = camera.get_position();
+    double distance_squared = 0.0;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        double delta = ((double)section[axis] + 0.5) * (double)ChunkSection::SIZE - position[axis];
+        distance_squared += delta * delta;
+    }
+
+    double distance = std::sqrt(distance_squared);
+
+    // Inside the hysteresis band around a boundary either level is acceptable.
+    unsigned finest = 0;
+    unsigned coarsest = 0;
+    for (double threshold : lod_distances) {
+        finest += distance > threshold + LOD_HYSTERESIS ? 1 : 0;
+        coarsest += distance > threshold - LOD_HYSTERESIS ? 1 : 0;
+    }
+
+    return std::clamp(current, finest, coarsest);
+}
+
+// Remeshes every section whose level of detail no longer suits its distance. The old mesh stays
+// in the terrain buffer and keeps drawing until the new one arrives.
+size_t Renderer::update_lods() {
+    const math::Vector3d& position = camera.get_position();
+    if (!lod_update_needed && (position - lod_update_position).length_squared() < LOD_UPDATE_DISTANCE * LOD_UPDATE_DISTANCE) {
+        return 0;
+    }
+
+    lod_update_needed = false;
+    lod_update_position = position;
+
+    lod_changes.clear();
+    for (const auto& [key, mesh] : section_meshes) {
+        math::Vector3i64 section = math::unpack_chunk_key(key);
+        if (select_lod(section, mesh.lod) != mesh.lod) {
+            lod_changes.push_back(section);
+        }
+    }
+
+    for (const math::Vector3i64& section : lod_changes) {
+        request_mesh(section, true);
+    }
+
+    return lod_changes.size();
+}
+
+size_t Renderer::sync_meshes() {
+    size_t changes = update_lods();
+    while (pending_meshes != 0) {
+        upload_finished_meshes();
+        std::this_thread::yield();
+    }
+
+    return changes;
+}
+
+void Renderer::upload_finished_meshes() {
+    finished_meshes.clear();
+    mesh_worker.poll(finished_meshes);
+
+    for (MeshWorker::Result& result : finished_meshes) {
+        --pending_meshes;
+
+        auto it = section_meshes.find(result.key);
+        if (it == section_meshes.end() || result.version != it->second.version) {
+            continue;
+        }
+
+        SectionMesh& mesh = it->second;
+        if (result.mesh.has_culling_data) {
+            mesh.culling_data_pending = false;
+
+            math::Vector3i64 section = math::unpack_chunk_key(result.key);
+            if (!has_section_bounds) {
+                section_bounds_min = section;
+                section_bounds_max = section;
+                has_section_bounds = true;
+            }
+
+            for (size_t axis = 0; axis < 3; ++axis) {
+                section_bounds_min[axis] = std::min(section_bounds_min[axis], section[axis]);
+                section_bounds_max[axis] = std::max(section_bounds_max[axis], section[axis]);
+            }
+
+            if (result.mesh.face_connections != ALL_FACE_CONNECTIONS) {
+                section_connections[result.key] = result.mesh.face_connections;
+            } else {
+                section_connections.erase(result.key);
+            }
+
+            if (result.mesh.opaque_layers != 0) {
+                section_occluders[result.key] = result.mesh.opaque_layers;
+            } else {
+                section_occluders.erase(result.key);
+            }
+        }
+
+        if (mesh.handle != TerrainBuffer::INVALID_HANDLE) {
+            terrain_buffer.free(mesh.handle);
+            mesh.handle = TerrainBuffer::INVALID_HANDLE;
+        }
+
+        // A coarse mesh can lose everything to downsampling, but the section has to stay tracked
+        // to get its full detail mesh back when the camera comes closer.
+        if (result.mesh.is_empty() && mesh.lod == 0) {
+            free_slots.push_back(mesh.slot);
+            section_meshes.erase(it);
+            continue;
+        }
+
+        if (!result.mesh.is_empty()) {
+            mesh.handle = terrain_buffer.allocate(result.mesh);
+        }
+    }
+
+    if (log_remesh && pending_meshes == 0) {
+        log_remesh = false;
+        std::cout << "meshed " << section_meshes.size() << " sections (" << ChunkMesher::get_mode_name(mesher_mode)
+            << "): " << terrain_buffer.get_used_vertices() << " of " << terrain_buffer.get_vertex_capacity() << " buffered vertices" << std::endl;
+    }
+}
+
+void Renderer::upload_frame_data() {
+    std::copy_n(camera.get_view_projection().data(), 16, frame_data.view_projection);
+
+    const math::Vector3d& position = camera.get_position();
+    frame_data.camera_position[0] = (GLfloat)position.x();
+    frame_data.camera_position[1] = (GLfloat)position.y();
+    frame_data.camera_position[2] = (GLfloat)position.z();
+
+    std::copy_n(FOG_COLOR, 4, frame_data.fog_color);
+    frame_data.fog_time[0] = FOG_START;
+    frame_data.fog_time[1] = FOG_END;
+    frame_data.fog_time[2] = (GLfloat)(glfwGetTime() - start_time);
+
+    // Orphaned every frame, like the indirect buffer, so the upload never waits on the GPU.
+    gl_state.bind_buffer(GL_UNIFORM_BUFFER, frame_data_buffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &frame_data);
 }
 
-void Renderer::draw() {
-    int framebuffer_width, framebuffer_height;
-    glfwGetFramebufferSize(glfwGetCurrentContext(), &framebuffer_width, &framebuffer_height);
-    glViewport(0, 0, framebuffer_width, framebuffer_height);
+// Breadth-first search outwards from the camera's section. A step may leave a section through a
+// face only if a path of non-opaque blocks joins it to the face the search came in through, and
+// only moving away from the camera, so sight lines never double back. Anything the search does not
+// reach is walled off from the camera. A section is revisited when entered through a new face,
+// since that can open paths its first visit could not take.
+void Renderer::find_cave_visible_sections() {
+    cave_queue.clear();
+    cave_search_done = false;
+
+    if (!has_section_bounds) {
+        return;
+    }
+
+    // One section of air around the meshed ones, so paths can go over the top or around the sides.
+    cave_grid_min = section_bounds_min - math::Vector3i64((int64_t)1, (int64_t)1, (int64_t)1);
+    cave_grid_size = section_bounds_max - cave_grid_min + math::Vector3i64((int64_t)2, (int64_t)2, (int64_t)2);
+    cave_entered_faces.assign((size_t)(cave_grid_size.x() * cave_grid_size.y() * cave_grid_size.z()), 0);
+
+    const math::Vector3d& position = camera.get_position();
+    math::Vector3i64 start;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        start[axis] = (int64_t)std::floor(position[axis] / (double)ChunkSection::SIZE);
+    }
+
+    // From outside there is nothing to search through; draw whatever the frustum allows.
+    size_t start_index = get_cave_grid_index(start);
+    if (start_index == SIZE_MAX) {
+        return;
+    }
+
+    cave_entered_faces[start_index] = CAVE_START;
+    cave_queue.push_back(CaveStep {start, FACE_COUNT});
+
+    for (size_t head = 0; head < cave_queue.size(); ++head) {
+        CaveStep step = cave_queue[head];
+
+        auto connections_it = section_connections.find(math::pack_chunk_key(step.section));
+        uint16_t connections = connections_it != section_connections.end() ? connections_it->second : ALL_FACE_CONNECTIONS;
+
+        for (size_t face = 0; face < FACE_COUNT; ++face) {
+            if (step.entry_face != FACE_COUNT && (face == step.entry_face || !(connections & face_connection_bit((Face)step.entry_face, (Face)face)))) {
+                continue;
+            }
+
+            // The camera has to be on the near side of the face being crossed.
+            size_t axis = face / 2;
+            bool positive = face % 2 == 0;
+            double face_coordinate = (double)((step.section[axis] + (positive ? 1 : 0)) * ChunkSection::SIZE);
+            if (step.entry_face != FACE_COUNT && (positive ? position[axis] > face_coordinate : position[axis] < face_coordinate)) {
+                continue;
+            }
+
+            math::Vector3i64 neighbour = step.section;
+            neighbour[axis] += positive ? 1 : -1;
+            size_t neighbour_index = get_cave_grid_index(neighbour);
+            if (neighbour_index == SIZE_MAX) {
+                continue;
+            }
+
+            // Opposite faces differ only in the lowest bit of their index.
+            size_t entry_face = face ^ 1;
+            uint8_t& entered = cave_entered_faces[neighbour_index];
+            if (entered & ((1u << entry_face) | CAVE_OUTSIDE_FRUSTUM)) {
+                continue;
+            }
+
+            // Only the first visit pays for the frustum test.
+            if (entered == 0) {
+                math::Vector3f min = camera.to_render_space(math::vector_cast<double>(neighbour) * (double)ChunkSection::SIZE);
+                math::Vector3f max = min + math::Vector3f((float)ChunkSection::SIZE, (float)ChunkSection::SIZE, (float)ChunkSection::SIZE);
+                if (camera.get_frustum().classify_aabb(min, max) == math::Containment::Outside) {
+                    entered = CAVE_OUTSIDE_FRUSTUM;
+                    continue;
+                }
+            }
+
+            entered |= (uint8_t)(1u << entry_face);
+            cave_queue.push_back(CaveStep {neighbour, entry_face});
+        }
+    }
+
+    cave_search_done = true;
+}
+
+// SIZE_MAX for sections outside the grid.
+size_t Renderer::get_cave_grid_index(const math::Vector3i64& section) const {
+    math::Vector3i64 local = section - cave_grid_min;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        if (local[axis] < 0 || local[axis] >= cave_grid_size[axis]) {
+            return SIZE_MAX;
+        }
+    }
 
-    double mouse_x, mouse_y;
-    glfwGetCursorPos(glfwGetCurrentContext(), &mouse_x, &mouse_y);
-    mouse_x = 2.0 * (mouse_x / framebuffer_width) - 1.0;
-    mouse_y = 1.0 - 2.0 * (mouse_y / framebuffer_height);
+    return (size_t)((local.y() * cave_grid_size.z() + local.z()) * cave_grid_size.x() + local.x());
+}
 
-    math::Vector4f movement;
-    if (glfwGetKey(glfwGetCurrentContext(), GLFW_KEY_W) == GLFW_PRESS) {
-        movement.z() += 1.0f;
+bool Renderer::is_cave_visible(const math::Vector3i64& section) const {
+    if (!cave_search_done) {
+        return true;
     }
 
-    if (glfwGetKey(glfwGetCurrentContext(), GLFW_KEY_S) == GLFW_PRESS) {
-        movement.z() -= 1.0f;
+    size_t index = get_cave_grid_index(section);
+    return index != SIZE_MAX && (cave_entered_faces[index] & ~CAVE_OUTSIDE_FRUSTUM) != 0;
+}
+
+void Renderer::rasterize_occluders() {
+    occluders.clear();
+    for (const auto& [key, opaque_layers] : section_occluders) {
+        math::Vector3d origin = math::vector_cast<double>(math::unpack_chunk_key(key)) * (double)ChunkSection::SIZE;
+        math::Vector3f min = camera.to_render_space(origin);
+        math::Vector3f max = min + math::Vector3f((float)ChunkSection::SIZE, (float)opaque_layers, (float)ChunkSection::SIZE);
+
+        math::Vector3f center = (min + max) * 0.5f;
+        float distance_squared = center.dot(center);
+        if (distance_squared <= MAX_OCCLUDER_DISTANCE * MAX_OCCLUDER_DISTANCE) {
+            occluders.push_back(Occluder {distance_squared, min, max});
+        }
     }
 
-    if (glfwGetKey(glfwGetCurrentContext(), GLFW_KEY_D) == GLFW_PRESS) {
-        movement.x() += 1.0f;
+    if (occluders.size() > MAX_OCCLUDERS) {
+        std::nth_element(occluders.begin(), occluders.begin() + MAX_OCCLUDERS, occluders.end(), [](const Occluder& a, const Occluder& b) {
+            return a.distance_squared < b.distance_squared;
+        });
+
+        occluders.resize(MAX_OCCLUDERS);
     }
 
-    if (glfwGetKey(glfwGetCurrentContext(), GLFW_KEY_A) == GLFW_PRESS) {
-        movement.x() -= 1.0f;
+    occlusion_buffer.clear(camera.get_view_projection());
+    for (const Occluder& occluder : occluders) {
+        occlusion_buffer.rasterize_box(occluder.min, occluder.max);
     }
 
-    math::Vector4f direction = math::rotation_y(mouse_x) * movement.normalize();
-    if (!movement.is_zero()) {
-        view_position += math::Vector3f(direction.x(), 0.0f, direction.z()) * 0.08f;
+    occlusion_buffer.build_hierarchy();
+}
+
+void Renderer::cull_chunks() {
+    cull_meshes.clear();
+    cull_keys.clear();
+    cull_offsets.clear();
+
+    for (const auto& [key, mesh] : section_meshes) {
+        if (mesh.handle == TerrainBuffer::INVALID_HANDLE) {
+            continue;
+        }
+
+        math::Vector3d origin = math::vector_cast<double>(math::unpack_chunk_key(key)) * (double)ChunkSection::SIZE;
+        cull_meshes.push_back(&mesh);
+        cull_keys.push_back(key);
+        cull_offsets.push_back(camera.to_render_space(origin));
     }
 
-    if (glfwGetKey(glfwGetCurrentContext(), GLFW_KEY_SPACE) == GLFW_PRESS) {
-        view_position.y() += 0.08f;
+    size_t count = cull_meshes.size();
+    for (std::vector<float>* stream : {&cull_min_x, &cull_min_y, &cull_min_z, &cull_max_x, &cull_max_y, &cull_max_z}) {
+        stream->resize(count);
     }
 
-    if (glfwGetKey(glfwGetCurrentContext(), GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS) {
-        view_position.y() -= 0.08f;
+    cull_results.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const math::Vector3f& offset = cull_offsets[i];
+        cull_min_x[i] = offset.x();
+        cull_min_y[i] = offset.y();
+        cull_min_z[i] = offset.z();
+        cull_max_x[i] = offset.x() + (float)ChunkSection::SIZE;
+        cull_max_y[i] = offset.y() + (float)ChunkSection::SIZE;
+        cull_max_z[i] = offset.z() + (float)ChunkSection::SIZE;
     }
 
-    math::Matrix4f translation = math::translation(
-        -view_position.x(), -view_position.y(), -view_position.z()
+    camera.get_frustum().classify_aabbs(
+        math::AABBStreams<const float> {
+            {cull_min_x, cull_min_y, cull_min_z},
+            {cull_max_x, cull_max_y, cull_max_z}
+        },
+        cull_results
     );
 
-    math::Matrix4f rotation_y = math::rotation_y(-mouse_x);
-    math::Matrix4f rotation_x = math::rotation_x(-mouse_y);
+    if (cave_culling) {
+        find_cave_visible_sections();
+    }
+
+    if (occlusion_culling) {
+        rasterize_occluders();
+    }
 
-    math::Matrix4f projection = math::perspective_projection(
+    frame_stats.cave_culled_sections = 0;
+    frame_stats.occluded_sections = 0;
+    frame_stats.lod_sections.fill(0);
+    visible_meshes.clear();
+    section_offsets.resize((size_t)slot_count * 4);
+    for (size_t i = 0; i < count; ++i) {
+        if (cull_results[i] == math::Containment::Outside) {
+            continue;
+        }
+
+        if (cave_culling && !is_cave_visible(math::unpack_chunk_key(cull_keys[i]))) {
+            ++frame_stats.cave_culled_sections;
+            continue;
+        }
+
+        const math::Vector3f& offset = cull_offsets[i];
+        if (occlusion_culling && occlusion_buffer.is_occluded(
+            offset,
+            offset + math::Vector3f((float)ChunkSection::SIZE, (float)ChunkSection::SIZE, (float)ChunkSection::SIZE)
+        )) {
+            ++frame_stats.occluded_sections;
+            continue;
+        }
+
+        GLfloat* slot_offset = &section_offsets[(size_t)cull_meshes[i]->slot * 4];
+        slot_offset[0] = offset.x();
+        slot_offset[1] = offset.y();
+        slot_offset[2] = offset.z();
+        visible_meshes.push_back(cull_meshes[i]->handle);
+        ++frame_stats.lod_sections[cull_meshes[i]->lod];
+    }
+}
+
+void Renderer::draw_chunks() {
+    gl_state.bind_buffer(GL_TEXTURE_BUFFER, section_offset_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, section_offsets.size() * sizeof(GLfloat), section_offsets.data(), GL_STREAM_DRAW);
+    gl_state.bind_texture(0, GL_TEXTURE_BUFFER, section_offset_texture);
+    block_textures.bind(BLOCK_TEXTURE_UNIT);
+
+    terrain_buffer.bind();
+    terrain_buffer.draw(visible_meshes);
+}
+
+void Renderer::set_mesher_mode(ChunkMesher::Mode mode) {
+    mesher_mode = mode;
+    remesh_all();
+}
+
+void Renderer::set_lod_enabled(bool enabled) {
+    lod_enabled = enabled;
+    lod_update_needed = true;
+}
+
+void Renderer::set_lod_distances(const LodDistances& distances) {
+    assert(std::adjacent_find(distances.begin(), distances.end(), std::greater_equal<>()) == distances.end());
+
+    lod_distances = distances;
+    lod_update_needed = true;
+}
+
+void Renderer::draw(int width, int height) {
+    using Clock = std::chrono::steady_clock;
+    auto elapsed_ms = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    gl_state.begin_frame();
+    gpu_profiler.begin_frame();
+    GpuProfiler::Scope total_scope(gpu_profiler, "total");
+
+    gl_state.set_viewport(0, 0, width, height);
+
+    camera.set_perspective(
         math::pi<float>() / 2.0f,
-        (float)framebuffer_width / (float)framebuffer_height,
+        (float)width / (float)height,
         0.1f,
-        100.0f
+        1000.0f
     );
 
-    glUniformMatrix4fv(
-        glGetUniformLocation(shader_program.get_handle(), "u_projection"),
-        1,
-        GL_FALSE,
-        (projection * rotation_x * rotation_y * translation).get_flat_data().data()
-    );
+    Clock::time_point stage_start = Clock::now();
+    update_lods();
+    upload_finished_meshes();
+    frame_stats.upload_ms = elapsed_ms(stage_start);
 
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    stage_start = Clock::now();
+    cull_chunks();
+    frame_stats.cull_ms = elapsed_ms(stage_start);
+    frame_stats.visible_sections = visible_meshes.size();
 
-    shader_program.use();
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-}
+    stage_start = Clock::now();
+    {
+        GpuProfiler::Scope clear_scope(gpu_profiler, "clear");
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+
+    {
+        GpuProfiler::Scope terrain_scope(gpu_profiler, "terrain");
+        upload_frame_data();
+        gl_state.use_program(shader_program.get_handle());
+
+        draw_chunks();
+    }
 
+    frame_stats.submit_ms = elapsed_ms(stage_start);
+}
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include "ShaderProgram.hpp"
 
+#include <algorithm>
 #include <stdexcept>
+#include <cassert>
 #include <cstdint>
 #include <iostream>
+#include <vector>
 
 static constexpr size_t info_log_size = 512;
 
@@ -41,8 +44,106 @@ void ShaderProgram::link() {
     if (!success) {
         throw std::runtime_error("failed to link shader program");
     }
+
+    reflect();
+}
+
+void ShaderProgram::reflect() {
+    uniforms.clear();
+    uniform_blocks.clear();
+
+    GLint max_name_length = 0;
+    glGetProgramiv(shader_program_handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+    GLint max_block_name_length = 0;
+    glGetProgramiv(shader_program_handle, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_block_name_length);
+
+    std::vector<GLchar> name(std::max(max_name_length, max_block_name_length) + 1);
+
+    GLint uniform_count = 0;
+    glGetProgramiv(shader_program_handle, GL_ACTIVE_UNIFORMS, &uniform_count);
+    for (GLint i = 0; i < uniform_count; ++i) {
+        Uniform uniform;
+        GLsizei length = 0;
+        glGetActiveUniform(shader_program_handle, (GLuint)i, (GLsizei)name.size(), &length, &uniform.size, &uniform.type, name.data());
+
+        // Members of uniform blocks have no location; they are set through the block's buffer.
+        uniform.location = glGetUniformLocation(shader_program_handle, name.data());
+        if (uniform.location == -1) {
+            continue;
+        }
+
+        // Arrays are reported as "name[0]"; store them under the plain name.
+        std::string_view key(name.data(), (size_t)length);
+        if (key.ends_with("[0]")) {
+            key.remove_suffix(3);
+        }
+
+        uniforms.emplace(key, uniform);
+    }
+
+    GLint block_count = 0;
+    glGetProgramiv(shader_program_handle, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+    for (GLint i = 0; i < block_count; ++i) {
+        UniformBlock block;
+        block.index = (GLuint)i;
+
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(shader_program_handle, block.index, (GLsizei)name.size(), &length, name.data());
+        glGetActiveUniformBlockiv(shader_program_handle, block.index, GL_UNIFORM_BLOCK_DATA_SIZE, &block.data_size);
+
+        uniform_blocks.emplace(std::string_view(name.data(), (size_t)length), block);
+    }
+}
+
+const ShaderProgram::Uniform* ShaderProgram::find_uniform(std::string_view name) const {
+    auto it = uniforms.find(name);
+    return it != uniforms.end() ? &it->second : nullptr;
+}
+
+const ShaderProgram::UniformBlock* ShaderProgram::find_uniform_block(std::string_view name) const {
+    auto it = uniform_blocks.find(name);
+    return it != uniform_blocks.end() ? &it->second : nullptr;
 }
 
-void ShaderProgram::use() {
-    glUseProgram(shader_program_handle);
+const ShaderProgram::Uniform* ShaderProgram::find_uniform(std::string_view name, GLenum type) const {
+    const Uniform* uniform = find_uniform(name);
+    assert(!uniform || uniform->type == type);
+    return uniform;
+}
+
+void ShaderProgram::set_uniform(std::string_view name, GLint value) {
+    // Samplers and booleans are set as integers too, so the type is not checked here.
+    if (const Uniform* uniform = find_uniform(name)) {
+        glUniform1i(uniform->location, value);
+    }
+}
+
+void ShaderProgram::set_uniform(std::string_view name, GLfloat value) {
+    if (const Uniform* uniform = find_uniform(name, GL_FLOAT)) {
+        glUniform1f(uniform->location, value);
+    }
+}
+
+void ShaderProgram::set_uniform(std::string_view name, const math::Vector3f& value) {
+    if (const Uniform* uniform = find_uniform(name, GL_FLOAT_VEC3)) {
+        glUniform3fv(uniform->location, 1, value.data());
+    }
+}
+
+void ShaderProgram::set_uniform(std::string_view name, const math::Vector4f& value) {
+    if (const Uniform* uniform = find_uniform(name, GL_FLOAT_VEC4)) {
+        glUniform4fv(uniform->location, 1, value.data());
+    }
+}
+
+void ShaderProgram::set_uniform(std::string_view name, const math::Matrix4f& value) {
+    if (const Uniform* uniform = find_uniform(name, GL_FLOAT_MAT4)) {
+        glUniformMatrix4fv(uniform->location, 1, GL_FALSE, value.data());
+    }
+}
+
+void ShaderProgram::bind_uniform_block(std::string_view name, GLuint binding) {
+    if (const UniformBlock* block = find_uniform_block(name)) {
+        glUniformBlockBinding(shader_program_handle, block->index, binding);
+    }
 }
\ No newline at end of file
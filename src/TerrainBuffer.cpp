@@ -0,0 +1,221 @@
+#include "TerrainBuffer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+#ifndef GL_DRAW_INDIRECT_BUFFER
+    #define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+TerrainBuffer::TerrainBuffer(GLState& gl_state, size_t vertex_capacity) : gl_state(gl_state), vertex_allocator(vertex_capacity) {
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &quad_index_buffer);
+
+    gl_state.bind_buffer(GL_COPY_WRITE_BUFFER, VBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, vertex_capacity * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+
+    std::vector<GLushort> quad_indices;
+    quad_indices.reserve(QUADS_PER_DRAW * 6);
+    for (size_t quad = 0; quad < QUADS_PER_DRAW; ++quad) {
+        GLushort base = (GLushort)(quad * 4);
+        for (GLushort index : {0, 1, 2, 2, 3, 0}) {
+            quad_indices.push_back((GLushort)(base + index));
+        }
+    }
+
+    gl_state.bind_buffer(GL_COPY_WRITE_BUFFER, quad_index_buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, quad_indices.size() * sizeof(GLushort), quad_indices.data(), GL_STATIC_DRAW);
+
+    bind_buffers();
+
+    if (glfwExtensionSupported("GL_ARB_multi_draw_indirect") && glfwExtensionSupported("GL_ARB_draw_indirect")) {
+        multi_draw_elements_indirect = (MultiDrawElementsIndirect)glfwGetProcAddress("glMultiDrawElementsIndirect");
+    }
+
+    if (multi_draw_elements_indirect) {
+        glGenBuffers(1, &indirect_buffer);
+    }
+}
+
+TerrainBuffer::~TerrainBuffer() noexcept {
+    if (indirect_buffer != 0) {
+        gl_state.forget_buffer(indirect_buffer);
+        glDeleteBuffers(1, &indirect_buffer);
+    }
+
+    gl_state.forget_buffer(VBO);
+    gl_state.forget_buffer(quad_index_buffer);
+    gl_state.forget_vertex_array(VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &quad_index_buffer);
+    glDeleteVertexArrays(1, &VAO);
+}
+
+void TerrainBuffer::bind_buffers() {
+    gl_state.bind_vertex_array(VAO);
+    gl_state.bind_buffer(GL_ARRAY_BUFFER, VBO);
+    gl_state.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, quad_index_buffer);
+
+    glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(Vertex), (void*)offsetof(Vertex, data));
+    glEnableVertexAttribArray(0);
+}
+
+TerrainBuffer::Handle TerrainBuffer::allocate(const ChunkMeshData& data) {
+    assert(!data.is_empty() && data.vertices.size() % 4 == 0);
+
+    Range range;
+    range.vertex_count = data.vertices.size();
+    range.vertex_offset = vertex_allocator.allocate(range.vertex_count);
+
+    if (range.vertex_offset == BufferAllocator::INVALID_OFFSET) {
+        // Holes add up to enough space: compact before paying for a bigger buffer.
+        if (vertex_allocator.get_free_size() >= range.vertex_count) {
+            defragment();
+            range.vertex_offset = vertex_allocator.allocate(range.vertex_count);
+        }
+
+        if (range.vertex_offset == BufferAllocator::INVALID_OFFSET) {
+            size_t vertex_capacity = get_vertex_capacity();
+            while (vertex_capacity - get_used_vertices() < range.vertex_count) {
+                vertex_capacity *= 2;
+            }
+
+            replace_buffer(vertex_capacity);
+            range.vertex_offset = vertex_allocator.allocate(range.vertex_count);
+            assert(range.vertex_offset != BufferAllocator::INVALID_OFFSET);
+        }
+    }
+
+    gl_state.bind_buffer(GL_COPY_WRITE_BUFFER, VBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, range.vertex_offset * sizeof(Vertex), range.vertex_count * sizeof(Vertex), data.vertices.data());
+
+    Handle handle;
+    if (free_handles.empty()) {
+        handle = (Handle)ranges.size();
+        ranges.push_back(range);
+        live.push_back(1);
+    } else {
+        handle = free_handles.back();
+        free_handles.pop_back();
+        ranges[handle] = range;
+        live[handle] = 1;
+    }
+
+    return handle;
+}
+
+void TerrainBuffer::free(Handle handle) {
+    assert(handle < ranges.size() && live[handle]);
+
+    const Range& range = ranges[handle];
+    vertex_allocator.free(range.vertex_offset, range.vertex_count);
+
+    live[handle] = 0;
+    free_handles.push_back(handle);
+}
+
+void TerrainBuffer::defragment() {
+    replace_buffer(get_vertex_capacity());
+}
+
+// Copies the live ranges into a freshly created buffer with glCopyBufferSubData, packed in offset
+// order, and then points the VAO at the new buffer. Serves both growth and defragmentation.
+void TerrainBuffer::replace_buffer(size_t vertex_capacity) {
+    GLuint new_buffer;
+    glGenBuffers(1, &new_buffer);
+
+    gl_state.bind_buffer(GL_COPY_WRITE_BUFFER, new_buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, vertex_capacity * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+
+    std::vector<Handle> order;
+    for (Handle handle = 0; handle < ranges.size(); ++handle) {
+        if (live[handle]) {
+            order.push_back(handle);
+        }
+    }
+
+    std::sort(order.begin(), order.end(), [this](Handle a, Handle b) {
+        return ranges[a].vertex_offset < ranges[b].vertex_offset;
+    });
+
+    gl_state.bind_buffer(GL_COPY_READ_BUFFER, VBO);
+    size_t vertex_end = 0;
+    for (Handle handle : order) {
+        Range& range = ranges[handle];
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, range.vertex_offset * sizeof(Vertex), vertex_end * sizeof(Vertex), range.vertex_count * sizeof(Vertex));
+        range.vertex_offset = vertex_end;
+        vertex_end += range.vertex_count;
+    }
+
+    gl_state.forget_buffer(VBO);
+    glDeleteBuffers(1, &VBO);
+    VBO = new_buffer;
+
+    vertex_allocator.reset(vertex_capacity, vertex_end);
+
+    bind_buffers();
+}
+
+const TerrainBuffer::Range& TerrainBuffer::get_range(Handle handle) const {
+    assert(handle < ranges.size() && live[handle]);
+    return ranges[handle];
+}
+
+void TerrainBuffer::bind() {
+    gl_state.bind_vertex_array(VAO);
+}
+
+void TerrainBuffer::draw(std::span<const Handle> handles) {
+    if (handles.empty()) {
+        return;
+    }
+
+    // Base vertices step by whole batches of quads so the shared indices stay in range.
+    auto for_each_batch = [this, handles](auto&& emit) {
+        for (Handle handle : handles) {
+            const Range& range = ranges[handle];
+            size_t quads = range.vertex_count / 4;
+            for (size_t first = 0; first < quads; first += QUADS_PER_DRAW) {
+                emit((GLsizei)(std::min(QUADS_PER_DRAW, quads - first) * 6), (GLint)(range.vertex_offset + first * 4));
+            }
+        }
+    };
+
+    if (multi_draw_elements_indirect) {
+        indirect_commands.clear();
+        for_each_batch([this](GLsizei count, GLint base_vertex) {
+            indirect_commands.push_back(IndirectCommand {(GLuint)count, 1, 0, base_vertex, 0});
+        });
+
+        // Orphaned every frame so the driver never waits on last frame's commands.
+        size_t size = indirect_commands.size() * sizeof(IndirectCommand);
+        gl_state.bind_buffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, indirect_commands.data());
+
+        multi_draw_elements_indirect(GL_TRIANGLES, GL_UNSIGNED_SHORT, nullptr, (GLsizei)indirect_commands.size(), 0);
+        gl_state.count_draw(indirect_commands.size());
+        return;
+    }
+
+    draw_counts.clear();
+    draw_offsets.clear();
+    draw_base_vertices.clear();
+    for_each_batch([this](GLsizei count, GLint base_vertex) {
+        draw_counts.push_back(count);
+        draw_offsets.push_back(nullptr);
+        draw_base_vertices.push_back(base_vertex);
+    });
+
+    glMultiDrawElementsBaseVertex(
+        GL_TRIANGLES,
+        draw_counts.data(),
+        GL_UNSIGNED_SHORT,
+        draw_offsets.data(),
+        (GLsizei)draw_counts.size(),
+        draw_base_vertices.data()
+    );
+    gl_state.count_draw(draw_counts.size());
+}
\ No newline at end of file
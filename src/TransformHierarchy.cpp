@@ -0,0 +1,179 @@
+#include "TransformHierarchy.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+TransformHierarchy::Node TransformHierarchy::add(const math::Matrix4f& local, Node parent) {
+    uint32_t parent_slot = NO_SLOT;
+    uint32_t depth = 0;
+    if (parent != NO_PARENT) {
+        assert(parent < node_slots.size() && node_slots[parent] != NO_SLOT);
+        parent_slot = node_slots[parent];
+        depth = depths[parent_slot] + 1;
+    }
+
+    Node node;
+    if (free_nodes.empty()) {
+        node = (Node)node_slots.size();
+        node_slots.push_back(NO_SLOT);
+    } else {
+        node = free_nodes.back();
+        free_nodes.pop_back();
+    }
+
+    if (!depths.empty() && depth < depths.back()) {
+        unsorted = true;
+    }
+
+    node_slots[node] = (uint32_t)parents.size();
+    parents.push_back(parent_slot);
+    depths.push_back(depth);
+    dirty.push_back(1);
+    locals.push_back(local);
+    worlds.push_back(local);
+    slot_nodes.push_back(node);
+    any_dirty = true;
+
+    return node;
+}
+
+void TransformHierarchy::remove(Node node) {
+    assert(node < node_slots.size() && node_slots[node] != NO_SLOT);
+    if (unsorted) {
+        sort_by_depth();
+    }
+
+    // Descendants always come after their ancestors, so one forward pass finds the whole subtree.
+    std::vector<uint8_t> removed(parents.size(), 0);
+    removed[node_slots[node]] = 1;
+    for (size_t slot = node_slots[node] + 1; slot < parents.size(); ++slot) {
+        if (parents[slot] != NO_SLOT && removed[parents[slot]]) {
+            removed[slot] = 1;
+        }
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(parents.size());
+    for (uint32_t slot = 0; slot < parents.size(); ++slot) {
+        if (removed[slot]) {
+            node_slots[slot_nodes[slot]] = NO_SLOT;
+            free_nodes.push_back(slot_nodes[slot]);
+        } else {
+            order.push_back(slot);
+        }
+    }
+
+    apply_order(order);
+}
+
+void TransformHierarchy::clear() {
+    parents.clear();
+    depths.clear();
+    dirty.clear();
+    locals.clear();
+    worlds.clear();
+    slot_nodes.clear();
+    node_slots.clear();
+    free_nodes.clear();
+    any_dirty = false;
+    unsorted = false;
+}
+
+void TransformHierarchy::set_local(Node node, const math::Matrix4f& local) {
+    assert(node < node_slots.size() && node_slots[node] != NO_SLOT);
+    uint32_t slot = node_slots[node];
+    locals[slot] = local;
+    dirty[slot] = 1;
+    any_dirty = true;
+}
+
+const math::Matrix4f& TransformHierarchy::get_local(Node node) const {
+    assert(node < node_slots.size() && node_slots[node] != NO_SLOT);
+    return locals[node_slots[node]];
+}
+
+const math::Matrix4f& TransformHierarchy::get_world(Node node) const {
+    assert(node < node_slots.size() && node_slots[node] != NO_SLOT);
+    return worlds[node_slots[node]];
+}
+
+TransformHierarchy::Node TransformHierarchy::get_parent(Node node) const {
+    assert(node < node_slots.size() && node_slots[node] != NO_SLOT);
+    uint32_t parent_slot = parents[node_slots[node]];
+    return parent_slot == NO_SLOT ? NO_PARENT : slot_nodes[parent_slot];
+}
+
+void TransformHierarchy::update() {
+    if (unsorted) {
+        sort_by_depth();
+    }
+
+    if (!any_dirty) {
+        return;
+    }
+
+    size_t count = parents.size();
+    for (size_t slot = 0; slot < count; ++slot) {
+        uint32_t parent = parents[slot];
+        if (parent == NO_SLOT) {
+            if (dirty[slot]) {
+                worlds[slot] = locals[slot];
+            }
+
+            continue;
+        }
+
+        // A moved parent drags its whole subtree along; the flag is pushed down as we go.
+        dirty[slot] |= dirty[parent];
+        if (dirty[slot]) {
+            worlds[slot] = worlds[parent] * locals[slot];
+        }
+    }
+
+    std::fill(dirty.begin(), dirty.end(), 0);
+    any_dirty = false;
+}
+
+void TransformHierarchy::sort_by_depth() {
+    std::vector<uint32_t> order(parents.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t lhs, uint32_t rhs) {
+        return depths[lhs] < depths[rhs];
+    });
+
+    apply_order(order);
+    unsorted = false;
+}
+
+void TransformHierarchy::apply_order(const std::vector<uint32_t>& order) {
+    std::vector<uint32_t> new_slots(parents.size(), NO_SLOT);
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        new_slots[order[i]] = i;
+    }
+
+    std::vector<uint32_t> new_parents(order.size());
+    std::vector<uint32_t> new_depths(order.size());
+    std::vector<uint8_t> new_dirty(order.size());
+    std::vector<math::Matrix4f> new_locals(order.size());
+    std::vector<math::Matrix4f> new_worlds(order.size());
+    std::vector<Node> new_slot_nodes(order.size());
+
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        uint32_t slot = order[i];
+        new_parents[i] = parents[slot] == NO_SLOT ? NO_SLOT : new_slots[parents[slot]];
+        new_depths[i] = depths[slot];
+        new_dirty[i] = dirty[slot];
+        new_locals[i] = locals[slot];
+        new_worlds[i] = worlds[slot];
+        new_slot_nodes[i] = slot_nodes[slot];
+        node_slots[slot_nodes[slot]] = i;
+    }
+
+    parents = std::move(new_parents);
+    depths = std::move(new_depths);
+    dirty = std::move(new_dirty);
+    locals = std::move(new_locals);
+    worlds = std::move(new_worlds);
+    slot_nodes = std::move(new_slot_nodes);
+}
\ No newline at end of file
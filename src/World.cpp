@@ -0,0 +1,109 @@
+#include "World.hpp"
+
+#include <cmath>
+
+#include "math/Coordinates.hpp"
+
+void World::generate(int64_t center_x, int64_t center_z, int64_t radius) {
+    for (int64_t z = center_z - radius; z <= center_z + radius; ++z) {
+        for (int64_t x = center_x - radius; x <= center_x + radius; ++x) {
+            generate_column(x, z);
+        }
+    }
+}
+
+ChunkSection* World::get_section(const math::Vector3i64& section) {
+    auto it = sections.find(math::pack_chunk_key(section));
+    return it == sections.end() ? nullptr : it->second.get();
+}
+
+const ChunkSection* World::get_section(const math::Vector3i64& section) const {
+    auto it = sections.find(math::pack_chunk_key(section));
+    return it == sections.end() ? nullptr : it->second.get();
+}
+
+ChunkSection& World::get_or_create_section(const math::Vector3i64& section) {
+    std::unique_ptr<ChunkSection>& slot = sections[math::pack_chunk_key(section)];
+    if (!slot) {
+        slot = std::make_unique<ChunkSection>();
+    }
+
+    return *slot;
+}
+
+Block World::get_block(const math::Vector3i64& position) const {
+    const ChunkSection* section = get_section(math::floor_div_pow2(position, ChunkSection::SIZE_SHIFT));
+    if (!section) {
+        return Block::Air;
+    }
+
+    math::Vector3i64 local = math::floor_mod_pow2(position, ChunkSection::SIZE_SHIFT);
+    return section->get((int)local.x(), (int)local.y(), (int)local.z());
+}
+
+void World::set_block(const math::Vector3i64& position, Block block) {
+    ChunkSection& section = get_or_create_section(math::floor_div_pow2(position, ChunkSection::SIZE_SHIFT));
+    math::Vector3i64 local = math::floor_mod_pow2(position, ChunkSection::SIZE_SHIFT);
+    section.set((int)local.x(), (int)local.y(), (int)local.z(), block);
+}
+
+static int terrain_height(double x, double z) {
+    double height = 48.0
+        + 14.0 * std::sin(x * 0.021) * std::cos(z * 0.017)
+        + 6.0 * std::sin((x + z) * 0.053)
+        + 2.0 * std::cos(x * 0.13 - z * 0.11);
+    return (int)std::floor(height);
+}
+
+static bool is_cave(double x, double y, double z) {
+    double density = std::sin(x * 0.09) * std::cos(z * 0.08) + std::sin(y * 0.15 + x * 0.03) * std::cos(z * 0.05 - y * 0.07);
+    return density > 1.1;
+}
+
+void World::generate_column(int64_t section_x, int64_t section_z) {
+    for (int64_t section_y = MIN_SECTION_Y; section_y <= MAX_SECTION_Y; ++section_y) {
+        get_or_create_section(math::Vector3i64(section_x, section_y, section_z));
+    }
+
+    for (int local_z = 0; local_z < ChunkSection::SIZE; ++local_z) {
+        for (int local_x = 0; local_x < ChunkSection::SIZE; ++local_x) {
+            int64_t x = section_x * ChunkSection::SIZE + local_x;
+            int64_t z = section_z * ChunkSection::SIZE + local_z;
+            int height = terrain_height((double)x, (double)z);
+
+            for (int y = 0; y <= height && y < (MAX_SECTION_Y + 1) * ChunkSection::SIZE; ++y) {
+                Block block = Block::Stone;
+                if (y == height) {
+                    block = height < 40 ? Block::Sand : Block::Grass;
+                } else if (y > height - 4) {
+                    block = height < 40 ? Block::Sand : Block::Dirt;
+                }
+
+                if (y > 2 && y < height - 2 && is_cave((double)x, (double)y, (double)z)) {
+                    continue;
+                }
+
+                ChunkSection& section = get_or_create_section(math::Vector3i64(section_x, (int64_t)(y >> ChunkSection::SIZE_SHIFT), section_z));
+                section.set(local_x, y & (ChunkSection::SIZE - 1), local_z, block);
+            }
+
+            // A sparse grid of trees keeps some see-through blocks in the terrain.
+            if (height >= 44 && (x % 23 == 0) && (z % 19 == 0) && height + 7 < (MAX_SECTION_Y + 1) * ChunkSection::SIZE) {
+                for (int y = height + 1; y <= height + 5; ++y) {
+                    set_block(math::Vector3i64(x, (int64_t)y, z), Block::Log);
+                }
+
+                for (int64_t dy = 3; dy <= 6; ++dy) {
+                    for (int64_t dz = -2; dz <= 2; ++dz) {
+                        for (int64_t dx = -2; dx <= 2; ++dx) {
+                            math::Vector3i64 position(x + dx, height + dy, z + dz);
+                            if ((dx != 0 || dz != 0 || dy > 5) && get_block(position) == Block::Air) {
+                                set_block(position, Block::Leaves);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
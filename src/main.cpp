@@ -1,8 +1,26 @@
+#include <cstdlib>
 #include <iostream>
+#include <string_view>
 
 #include "Game.hpp"
 
-int main() {
-    Game game;
+int main(int argc, char** argv) {
+    Game::Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view argument = argv[i];
+        if (argument == "--bench") {
+            options.bench = true;
+        } else if (argument == "--frames" && i + 1 < argc) {
+            options.bench_frames = (size_t)std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--gpu-csv" && i + 1 < argc) {
+            options.gpu_csv_filename = argv[++i];
+        } else {
+            std::cerr << "usage: minecraft [--bench [--frames 1000] [--gpu-csv file.csv]]" << std::endl;
+            return 2;
+        }
+    }
+
+    Game game(options);
     game.loop();
 }
\ No newline at end of file